@@ -26,7 +26,9 @@
 #include <QQmlApplicationEngine>
 #include <QtConcurrent>
 
-class Application final : public QObject
+class Application final
+    : public QObject
+    , public DataProviderHost
 {
     Q_OBJECT
 
@@ -38,6 +40,8 @@ class Application final : public QObject
 
     Q_PROPERTY(bool isLoaded READ getLoaded NOTIFY notifyLoadedChanged)
 
+    Q_PROPERTY(bool refreshing READ getRefreshing NOTIFY notifyRefreshingChanged)
+
     Q_PROPERTY(QString loadingTitle READ getLoadingTitle NOTIFY notifyLoadingTitleChanged)
 
     Q_PROPERTY(QString version READ getVersion NOTIFY notifyVersionChanged)
@@ -66,7 +70,7 @@ public:
     int run() noexcept;
 
     /**
-     * Loads/Re-loads intrinsic data.
+     * Checks for updated intrinsic data in the background while the existing data remains in use.
      */
     Q_INVOKABLE void resetData() noexcept;
 
@@ -75,7 +79,7 @@ public:
      * @param title    The title for the dialog box.
      * @param callback The callback function called when the dialog is closed.
      */
-    void addOKDialog(const QString& title, const std::function<void()>& callback);
+    void addOKDialog(const QString& title, const std::function<void()>& callback) override;
 
     /**
      * Gets whether a new OK dialog is required.
@@ -108,7 +112,7 @@ public:
      * Sets the progress value.
      * @param newProgress The progress.
      */
-    void setProgress(float newProgress) noexcept;
+    void setProgress(float newProgress) noexcept override;
 
     /** Notify the GUI that the progress has changed. */
     Q_SIGNAL void notifyProgressChanged() const;
@@ -128,6 +132,27 @@ public:
     /** Notify the GUI that the loaded has changed. */
     Q_SIGNAL void notifyLoadedChanged() const;
 
+    /**
+     * Gets whether the application is shutting down.
+     * @return True if it is, false if it is not.
+     */
+    bool getShutdown() const noexcept override;
+
+    /**
+     * Gets whether updated data is being created in the background.
+     * @return True if it is, false if it is not.
+     */
+    bool getRefreshing() const noexcept;
+
+    /**
+     * Sets whether updated data is being created in the background.
+     * @param newRefreshing True if refreshing.
+     */
+    void setRefreshing(bool newRefreshing) noexcept;
+
+    /** Notify the GUI that the refreshing state has changed. */
+    Q_SIGNAL void notifyRefreshingChanged() const;
+
     /**
      * Gets the title for the loading text.
      * @return The loading title.
@@ -138,7 +163,7 @@ public:
      * Sets the loading title.
      * @param title The new title.
      */
-    void setLoadingTitle(const QString& title) noexcept;
+    void setLoadingTitle(const QString& title) noexcept override;
 
     /** Notify the GUI that the available loading title has changed. */
     Q_SIGNAL void notifyLoadingTitleChanged() const;
@@ -167,6 +192,16 @@ private:
      */
     Q_SLOT void setupData() noexcept;
 
+    /**
+     * Replaces the data in the existing data models with updated data created in the background
+     */
+    Q_SLOT void updateData() noexcept;
+
+    /**
+     * Starts checking for updated data in the background
+     */
+    void startUpdate() noexcept;
+
     QGuiApplication app;
     QQmlApplicationEngine engine;
     TechnologyModel technologiesModel;
@@ -187,6 +222,8 @@ private:
     QMutex mutexOK;
     std::atomic<float> progress = 0.0F;
     std::atomic_bool loaded = false;
+    std::atomic_bool shutdown = false;
+    std::atomic_bool refreshing = false;
     QString loading = "Loading...";
     DataProvider provider;
     std::unique_ptr<QFuture<bool>> dataLoad = nullptr;
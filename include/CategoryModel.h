@@ -37,7 +37,8 @@ public:
     enum CategoryRole
     {
         CategoryRoleName = Qt::DisplayRole,
-        CategoryRoleChecked = Qt::UserRole
+        CategoryRoleChecked = Qt::UserRole,
+        CategoryRoleCount
     };
 
     Q_ENUM(CategoryRole)
@@ -100,9 +101,54 @@ public:
      */
     void load(QList<QString>& categories) noexcept;
 
+    /**
+     * Updates this model with new data while keeping the checked state of any existing items.
+     * @param [in,out] categories The data to load.
+     * @note Only the items that have changed are removed or inserted. This must be run from the primary thread.
+     */
+    void update(QList<QString>& categories) noexcept;
+
+    /**
+     * Updates the number of intrinsics that each item matches.
+     * @param counts The number of matching intrinsics for each item.
+     */
+    void setCounts(const QList<uint32_t>& counts) noexcept;
+
+    /**
+     * Checks or unchecks every item.
+     * @param checked True to check all items, false to uncheck them.
+     */
+    Q_INVOKABLE void setAllChecked(bool checked) noexcept;
+
+    /** Inverts the checked state of every item. */
+    Q_INVOKABLE void invertChecked() noexcept;
+
+    /**
+     * Checks only the named items, such as from a saved preset.
+     * @param names The names of the items to check. Any unknown names are ignored.
+     */
+    Q_INVOKABLE void setCheckedNames(const QList<QString>& names) noexcept;
+
+    /**
+     * Gets the names of all checked items.
+     * @returns The checked names.
+     */
+    [[nodiscard]] Q_INVOKABLE QList<QString> getCheckedNames() const noexcept;
+
+    /**
+     * Sets the checked state of every item at once.
+     * @param mask The new checked state of each item.
+     * @note Only a single change notification is sent regardless of the number of changed items.
+     */
+    void setCheckedMask(const FilterMask& mask) noexcept;
+
     /** Notify that internal data has changed. */
     Q_SIGNAL void categoriesyChanged() const;
 
 private:
     QList<StringChecked> allCategories; /**< The list of all known intrinsic categories */
+    FilterMask checkedMask;             /**< The checked state of each item in allCategories */
+
+    /** Updates the checked mask to match the checked state of each item. */
+    void updateMask() noexcept;
 };
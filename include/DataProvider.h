@@ -15,11 +15,50 @@
  * limitations under the License.
  */
 
+#include "Dataset.h"
+#include "FacetIndex.h"
 #include "InternalData.h"
+#include "PerformanceIndex.h"
+#include "SearchIndex.h"
 
-#include <QDomDocument>
+#include <QHash>
+#include <QIODevice>
 
-class Application;
+#include <functional>
+
+class Downloader;
+
+/** Receives status updates from a data provider */
+class DataProviderHost
+{
+public:
+    virtual ~DataProviderHost() noexcept = default;
+
+    /**
+     * Displays an dialog with an OK button.
+     * @param title    The title for the dialog box.
+     * @param callback The callback function called when the dialog is closed.
+     */
+    virtual void addOKDialog(const QString& title, const std::function<void()>& callback) = 0;
+
+    /**
+     * Sets the progress value.
+     * @param newProgress The progress.
+     */
+    virtual void setProgress(float newProgress) noexcept = 0;
+
+    /**
+     * Gets whether the host is shutting down, this is used to signal that any current loading should stop.
+     * @return True if it is, false if it is not.
+     */
+    [[nodiscard]] virtual bool getShutdown() const noexcept = 0;
+
+    /**
+     * Sets the loading title.
+     * @param title The new title.
+     */
+    virtual void setLoadingTitle(const QString& title) noexcept = 0;
+};
 
 class DataProvider
 {
@@ -34,15 +73,40 @@ public:
 
     /**
      * Constructor.
-     * @param [in] parent (Optional) If non-null, the parent.
+     * @param [in] parent The host that receives status updates.
      */
-    explicit DataProvider(Application* parent) noexcept;
+    explicit DataProvider(DataProviderHost* parent) noexcept;
 
     /**
      * Gets the data.
+     * @note Any existing stored data is used straight away even if it is out of date, use isStale and update to then
+     * check the upstream sources for changes.
      */
     bool setup() noexcept;
 
+    /**
+     * Checks the upstream sources for changes and recreates the data if required. This is designed to run in the
+     * background while the existing data is still in use, any new data is stored to a separate file that replaces the
+     * existing stored data the next time setup is called.
+     * @returns True if new data was created, false if the existing data is still current or could not be updated.
+     */
+    bool update() noexcept;
+
+    /**
+     * Gets whether the loaded data is old enough that upstream should be checked for changes.
+     * @returns True if it is, false if it is not.
+     */
+    [[nodiscard]] bool isStale() const noexcept;
+
+    /**
+     * Creates stored data from local copies of the upstream sources.
+     * @param intrinPath The Intel intrinsic guide XML file.
+     * @param uopsPath   The uops.info XML file.
+     * @param outputPath The file to write the stored data to.
+     * @returns True if it succeeds, false if it fails.
+     */
+    bool build(const QString& intrinPath, const QString& uopsPath, const QString& outputPath) noexcept;
+
     /** Clears this object to its blank/initial state. */
     void clear();
 
@@ -59,21 +123,59 @@ public:
     void addProgress(float value) noexcept;
 
     /**
-     * Gets the internal data.
-     * @returns The data.
+     * Gets the loaded data.
+     * @returns The data, nullptr if no data has been loaded.
+     */
+    [[nodiscard]] std::shared_ptr<Dataset> getDataset() const noexcept;
+
+    /**
+     * Gets the search index of the loaded data.
+     * @returns The search index, nullptr if no data has been loaded.
+     */
+    [[nodiscard]] std::shared_ptr<SearchIndex> getSearchIndex() const noexcept;
+
+    /**
+     * Gets the performance index of the loaded data.
+     * @returns The performance index, nullptr if no data has been loaded.
+     */
+    [[nodiscard]] std::shared_ptr<PerformanceIndex> getPerformanceIndex() const noexcept;
+
+    /**
+     * Gets the facet index of the loaded data.
+     * @returns The facet index, nullptr if no data has been loaded.
      */
-    [[nodiscard]] InternalData& getData() noexcept;
+    [[nodiscard]] std::shared_ptr<FacetIndex> getFacetIndex() const noexcept;
 
 private:
     /**
      * Loads this model from stored data.
+     * @param       fileName Filename of the stored data.
+     * @param [out] outdated Set to true if the stored data is old enough that upstream should be checked for changes.
+     */
+    [[nodiscard]] bool load(const QString& fileName, bool& outdated) noexcept;
+
+    /**
+     * Loads this model from the stored data embedded in the executable.
+     * @param [out] outdated Set to true if the stored data is old enough that upstream should be checked for changes.
      */
-    [[nodiscard]] bool load() noexcept;
+    [[nodiscard]] bool loadEmbedded(bool& outdated) noexcept;
 
     /**
-     * Store the model to stored data.
+     * Store the model to stored data and then use the stored data as the loaded data.
+     * @param fileName Filename of the stored data.
      */
-    [[nodiscard]] bool store() noexcept;
+    [[nodiscard]] bool store(const QString& fileName) noexcept;
+
+    /**
+     * Checks if the upstream sources have changed since the currently loaded data was created.
+     * @returns True if the loaded data can still be used, false if it must be recreated or shutdown was called.
+     */
+    [[nodiscard]] bool revalidate() noexcept;
+
+    /**
+     * Creates the search and performance indexes for the loaded data.
+     */
+    void createIndexes() noexcept;
 
     /**
      * Creates this model by retrieving new data.
@@ -81,18 +183,83 @@ private:
     [[nodiscard]] bool create() noexcept;
 
     /**
-     * Downloads to cache or loads from cache if already exists.
+     * Starts downloading to cache if it does not already exist.
+     * @param [in,out] dl       The downloader used to fetch the resource.
+     * @param          fileName Filename of the cache file.
+     * @param          name     The name of the download/cache.
+     * @param          url      URL of the resource.
+     * @returns The download identifier, or -1 if the cache already exists.
+     */
+    [[nodiscard]] int32_t startCache(
+        Downloader& dl, const QString& fileName, const QString& name, const QUrl& url) noexcept;
+
+    /**
+     * Gets the validators to check a source against upstream.
+     * @param url URL of the resource.
+     * @returns The stored validators of the loaded data, or its date if it has none.
+     */
+    [[nodiscard]] SourceValidator getValidator(const QUrl& url) const noexcept;
+
+    /**
+     * Formats a time for use in a HTTP header.
+     * @param time The time to format.
+     * @returns The formatted time.
+     */
+    [[nodiscard]] static QByteArray toHttpDate(const QDateTime& time) noexcept;
+
+    /**
+     * Waits for a download started with startCache to complete writing to the cache.
+     * @param [in,out] dl       The downloader used to fetch the resource.
+     * @param          id       The download identifier returned by startCache.
      * @param          fileName Filename of the cache file.
      * @param          name     The name of the download/cache.
-     * @param [in,out] dataXML  The data XML.
      * @param          url      URL of the resource.
      * @returns True if it succeeds, false if it fails.
      */
-    [[nodiscard]] bool downloadCache(
-        const QString& fileName, const QString& name, QDomDocument& dataXML, const QUrl& url) noexcept;
+    [[nodiscard]] bool finishCache(
+        Downloader& dl, int32_t id, const QString& fileName, const QString& name, const QUrl& url) noexcept;
+
+    /** A uops.info instruction reduced to the data needed to join it with the intrinsics */
+    struct UopsInstruction
+    {
+        QString extension;                /**< The name of the extension the instruction was listed under */
+        uint32_t order = 0;               /**< The position of the instruction within the document */
+        QList<Measurements> measurements; /**< The per architecture measurements */
+    };
+
+    /** The uops.info instructions keyed by iform, each list is kept in document order */
+    using UopsIndex = QHash<QString, QList<UopsInstruction>>;
+
+    /**
+     * Reads the Intel intrinsic guide XML directly from a stream.
+     * @param [in,out] device       The device to read the XML from.
+     * @param [out]    instructions The list of read intrinsics (without uops measurements).
+     * @returns True if it succeeds, false if it fails.
+     */
+    [[nodiscard]] bool parseIntrinsics(QIODevice& device, QList<Instruction>& instructions) noexcept;
+
+    /**
+     * Reads the uops.info XML directly from a stream keeping only the measurement data.
+     * @param [in,out] device The device to read the XML from.
+     * @param [out]    index  The read uops instructions.
+     * @returns True if it succeeds, false if it fails.
+     */
+    [[nodiscard]] bool parseUops(QIODevice& device, UopsIndex& index) noexcept;
+
+    InternalData data;                                  /**< The data used while creating new stored data */
+    std::shared_ptr<Dataset> dataset;                   /**< The loaded data */
+    std::shared_ptr<SearchIndex> searchIndex;           /**< The search index of the loaded data */
+    std::shared_ptr<PerformanceIndex> performanceIndex; /**< The performance index of the loaded data */
+    std::shared_ptr<FacetIndex> facetIndex;             /**< The facet index of the loaded data */
 
-    InternalData data;             /**< The data */
-    float progress = 0.0f;         /**< Stored value indicating total progress of all loading operations */
-    float progressModifier = 1.0f; /**< The progress modifier used to scale incoming progress values */
-    Application* parentApp;
+    float progress = 0.0f;                  /**< Stored value indicating total progress of all loading operations */
+    float progressModifier = 1.0f;          /**< The progress modifier used to scale incoming progress values */
+    uint32_t downloadCount = 0;             /**< The number of sources currently being downloaded */
+    bool stale = false;                     /**< True if the loaded data should be checked against upstream */
+    QString loadedFile;                     /**< The stored data file the loaded data was read from, if any */
+    QString cacheFile = "./dataCache";      /**< The stored data file */
+    QString updateFile = "./dataCache.new"; /**< Stored data created by update that replaces cacheFile on next setup */
+    QString intrinFile = "./intrin.xml";    /**< The Intel intrinsic guide XML cache file */
+    QString uopsFile = "./uops.xml";        /**< The uops.info XML cache file */
+    DataProviderHost* parentApp;
 };
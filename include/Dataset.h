@@ -0,0 +1,329 @@
+#pragma once
+/**
+ * Copyright Matthew Oliver
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "InternalData.h"
+
+#include <QByteArray>
+#include <QFile>
+#include <QMutex>
+#include <QStringView>
+
+#include <memory>
+
+/**
+ * Read only view of the stored intrinsic data.
+ * The data is stored as a header followed by fixed size records that reference into a shared UTF-16 string table.
+ * The measurements of all intrinsics are stored in a single table with each intrinsic referencing a range of it.
+ * The large, almost entirely ASCII, texts are instead stored back to back in a separate UTF-8 text table.
+ * All references are offsets so the data can be memory mapped and used in place without deserialising it.
+ * When stored to disk only the UTF-8 tables are compressed, every other table is kept uncompressed so that it is still
+ * used in place from the mapped file. The text table is split into independently compressed blocks that are
+ * decompressed in parallel when opened. The detail table holding the descriptions and operations is only shown for
+ * expanded intrinsics so its blocks are instead decompressed when first needed.
+ */
+class Dataset
+{
+public:
+    /** A reference to a string stored in the string table */
+    struct StringRef
+    {
+        uint32_t offset = 0; /**< The offset into the string table in UTF-16 code units */
+        uint32_t length = 0; /**< The length of the string in UTF-16 code units */
+    };
+
+    /** A reference to a text stored in the UTF-8 text table */
+    struct TextRef
+    {
+        uint32_t offset = 0; /**< The offset into the text table in bytes */
+        uint32_t length = 0; /**< The length of the text in bytes */
+    };
+
+    /** A range of entries stored in one of the record tables */
+    struct RangeRef
+    {
+        uint32_t offset = 0; /**< The index of the first entry */
+        uint32_t count = 0;  /**< The number of entries */
+    };
+
+    /** The file header found at the start of the data */
+    struct Header
+    {
+        uint32_t fileID = 0;           /**< Identifier used to detect invalid files */
+        uint32_t fileVersion = 0;      /**< The version of the data layout */
+        int64_t date = 0;              /**< The intrinsic list date stored as a julian day */
+        StringRef version;             /**< The intrinsic list version */
+        RangeRef technologies;         /**< All known intrinsic technologies. Range in the string reference table */
+        RangeRef types;                /**< All known intrinsic types. Range in the string reference table */
+        RangeRef categories;           /**< All known intrinsic categories. Range in the string reference table */
+        RangeRef validators;           /**< Source url, eTag and lastModified. Range in the string reference table */
+        RangeRef architectures;        /**< All measured architectures sorted by name. Range in the string references */
+        RangeRef ports;                /**< All distinct measured port usages. Range in the string reference table */
+        uint32_t instructions = 0;     /**< Byte offset of the instruction records */
+        uint32_t instructionCount = 0; /**< Number of instruction records */
+        uint32_t measurements = 0;     /**< Byte offset of the measurement records */
+        uint32_t measurementCount = 0; /**< Number of measurement records */
+        uint32_t indices = 0;          /**< Byte offset of the type/category index table */
+        uint32_t indexCount = 0;       /**< Number of entries in the index table */
+        uint32_t stringRefs = 0;       /**< Byte offset of the string reference table */
+        uint32_t stringRefCount = 0;   /**< Number of entries in the string reference table */
+        uint32_t strings = 0;          /**< Byte offset of the string table */
+        uint32_t stringLength = 0;     /**< Length of the string table in UTF-16 code units */
+        uint32_t texts = 0;            /**< Byte offset of the UTF-8 text table */
+        uint32_t textLength = 0;       /**< Length of the text table in bytes */
+        uint32_t details = 0;          /**< Byte offset of the UTF-8 detail table, always the last table */
+        uint32_t detailLength = 0;     /**< Length of the detail table in bytes */
+        uint32_t detailBlockCount = 0; /**< Number of compressed detail blocks, these follow the text blocks */
+        uint32_t reserved = 0;         /**< Unused, keeps the header size a multiple of 8 bytes */
+        uint32_t blockCount = 0;       /**< Number of compressed text blocks */
+        uint32_t blockSize = 0;        /**< The uncompressed size of each block in bytes, 0 if uncompressed */
+    };
+
+    /** The location of a compressed block in a stored file, the block index is stored at the text table offset */
+    struct BlockRecord
+    {
+        uint32_t offset = 0; /**< Byte offset of the compressed block within the file */
+        uint32_t size = 0;   /**< The compressed size of the block in bytes */
+    };
+
+    /** A single intrinsic */
+    struct InstructionRecord
+    {
+        TextRef signature;       /**< The return and parameter types and names, see SignatureFormatter */
+        StringRef name;          /**< The intrinsics name */
+        TextRef description;     /**< The description. Reference into the detail table */
+        TextRef operation;       /**< The pseudo code operation. Reference into the detail table */
+        StringRef header;        /**< The instructions required include header */
+        StringRef cpuidText;     /**< The required CPUID`s as user readable text */
+        StringRef typeText;      /**< The required types as user readable text */
+        StringRef categoryText;  /**< The categories of operation as user readable text */
+        StringRef instruction;   /**< The intrinsics assembly equivalent */
+        uint32_t technology = 0; /**< The required technology. Indexes into the technologies list */
+        RangeRef types;          /**< The data types operated on. Range in the index table */
+        RangeRef categories;     /**< The category of operation. Range in the index table */
+        RangeRef measurements;   /**< The list of measurements. Range in the measurement records */
+    };
+
+    /** A single uops measurement */
+    struct MeasurementRecord
+    {
+        uint32_t arch = 0;       /**< The processor architecture the measurement is for. Indexes the architectures */
+        uint32_t latency = 0;    /**< The measured latency */
+        uint32_t latencyMem = 0; /**< The measured maximum latency of memory operations */
+        float throughput = 0;    /**< The measured throughput */
+        uint32_t uops = 0;       /**< The instruction uops */
+        uint32_t ports = 0;      /**< The instruction ports. Indexes the port usages */
+    };
+
+    Dataset(const Dataset& other) = delete;
+
+    Dataset(Dataset&& other) noexcept = delete;
+
+    Dataset& operator=(const Dataset& other) = delete;
+
+    Dataset& operator=(Dataset&& other) noexcept = delete;
+
+    /** Destructor. */
+    ~Dataset() noexcept = default;
+
+    /**
+     * Opens stored data by memory mapping it, the compressed text table is decompressed into memory.
+     * @param fileName Filename of the file.
+     * @returns The data if it succeeds, nullptr if the file is missing, out of date or invalid.
+     */
+    [[nodiscard]] static std::shared_ptr<Dataset> open(const QString& fileName) noexcept;
+
+    /**
+     * Uses data stored in memory.
+     * @param [in,out] buffer The buffer containing the data.
+     * @returns The data if it succeeds, nullptr if the data is invalid.
+     */
+    [[nodiscard]] static std::shared_ptr<Dataset> open(QByteArray&& buffer) noexcept;
+
+    /**
+     * Converts intrinsic data into the stored format.
+     * @param data The data to convert.
+     * @returns The converted data.
+     */
+    [[nodiscard]] static QByteArray build(const InternalData& data) noexcept;
+
+    /**
+     * Compresses data created with build into the stored file format.
+     * @param data The data to compress.
+     * @returns The compressed data.
+     */
+    [[nodiscard]] static QByteArray compress(const QByteArray& data) noexcept;
+
+    /**
+     * Updates the date of already stored data.
+     * @param fileName Filename of the file.
+     * @param date     The new date.
+     * @returns True if it succeeds, false if it fails.
+     */
+    [[nodiscard]] static bool updateDate(const QString& fileName, const QDate& date) noexcept;
+
+    /**
+     * Gets the intrinsic list date.
+     * @returns The date.
+     */
+    [[nodiscard]] QDate getDate() const noexcept;
+
+    /**
+     * Gets the intrinsic list version.
+     * @returns The version.
+     */
+    [[nodiscard]] QStringView getVersion() const noexcept;
+
+    /**
+     * Gets the list of all known intrinsic technologies.
+     * @returns The technologies.
+     */
+    [[nodiscard]] QList<QString> getTechnologies() const noexcept;
+
+    /**
+     * Gets the list of all known intrinsic types.
+     * @returns The types.
+     */
+    [[nodiscard]] QList<QString> getTypes() const noexcept;
+
+    /**
+     * Gets the list of all known intrinsic categories.
+     * @returns The categories.
+     */
+    [[nodiscard]] QList<QString> getCategories() const noexcept;
+
+    /**
+     * Gets the list of all measured architectures.
+     * @returns The architectures sorted by name, a measurements arch indexes into this list.
+     */
+    [[nodiscard]] QList<QString> getArchitectures() const noexcept;
+
+    /**
+     * Gets the name of a measured architecture.
+     * @param arch Zero-based index of the architecture.
+     * @returns A view of the name that is valid for the lifetime of this object.
+     */
+    [[nodiscard]] QStringView getArchitecture(uint32_t arch) const noexcept;
+
+    /**
+     * Gets a measured port usage.
+     * @param ports Zero-based index of the port usage.
+     * @returns A view of the port usage that is valid for the lifetime of this object.
+     */
+    [[nodiscard]] QStringView getPorts(uint32_t ports) const noexcept;
+
+    /**
+     * Gets the validators of each upstream source.
+     * @returns The validators keyed by url.
+     */
+    [[nodiscard]] QMap<QString, SourceValidator> getValidators() const noexcept;
+
+    /**
+     * Gets the number of intrinsics.
+     * @returns The instruction count.
+     */
+    [[nodiscard]] uint32_t getInstructionCount() const noexcept;
+
+    /**
+     * Gets an intrinsic.
+     * @param index Zero-based index of the intrinsic.
+     * @returns The instruction.
+     */
+    [[nodiscard]] const InstructionRecord& getInstruction(uint32_t index) const noexcept;
+
+    /**
+     * Gets a measurement.
+     * @param index Zero-based index of the measurement.
+     * @returns The measurement.
+     */
+    [[nodiscard]] const MeasurementRecord& getMeasurement(uint32_t index) const noexcept;
+
+    /**
+     * Gets an entry from the type/category index table.
+     * @param index Zero-based index of the entry.
+     * @returns The index.
+     */
+    [[nodiscard]] uint32_t getIndex(uint32_t index) const noexcept;
+
+    /**
+     * Gets a string from the string table.
+     * @param string The reference to the string.
+     * @returns A view of the string that is valid for the lifetime of this object.
+     */
+    [[nodiscard]] QStringView getString(const StringRef& string) const noexcept;
+
+    /**
+     * Gets a text from the text table.
+     * @param text The reference to the text.
+     * @returns The text converted from UTF-8.
+     */
+    [[nodiscard]] QString getText(const TextRef& text) const noexcept;
+
+    /**
+     * Gets a text from the detail table.
+     * @param text The reference to the text.
+     * @returns The text converted from UTF-8, empty if the text could not be decompressed.
+     * @note Decompressed blocks are cached so that nearby texts can be read without decompressing them again.
+     */
+    [[nodiscard]] QString getDetail(const TextRef& text) const noexcept;
+
+private:
+    QFile file;                                             /**< The memory mapped file */
+    QByteArray buffer;                                      /**< The in memory data when not memory mapped */
+    const uchar* base = nullptr;                            /**< The start of the data */
+    qint64 size = 0;                                        /**< The size of the data in bytes */
+    const Header* header = nullptr;                         /**< The data header */
+    const InstructionRecord* instructions = nullptr;        /**< The instruction records */
+    const MeasurementRecord* measurements = nullptr;        /**< The measurement records */
+    const uint32_t* indices = nullptr;                      /**< The type/category index table */
+    const StringRef* stringRefs = nullptr;                  /**< The string reference table */
+    const char16_t* strings = nullptr;                      /**< The string table */
+    QByteArray textBuffer;                                  /**< The decompressed text table when stored compressed */
+    const char* texts = nullptr;                            /**< The UTF-8 text table */
+    const char* details = nullptr;                          /**< The UTF-8 detail table, nullptr if still compressed */
+    const BlockRecord* detailBlocks = nullptr;              /**< The index of the compressed detail blocks */
+    mutable QMutex detailMutex;                             /**< Guards the detail block cache */
+    mutable QList<QPair<uint32_t, QByteArray>> detailCache; /**< Recently used detail blocks, most recent last */
+
+    Dataset() noexcept = default;
+
+    /**
+     * Decompresses the text blocks of a stored file into the text buffer and locates the detail blocks.
+     * @returns True if it succeeds, false if it fails.
+     */
+    [[nodiscard]] bool decompress() noexcept;
+
+    /**
+     * Gets a decompressed block of the detail table.
+     * @param block Zero-based index of the block.
+     * @returns The block, empty if it could not be decompressed.
+     * @note The detail mutex must be held.
+     */
+    [[nodiscard]] QByteArray getDetailBlock(uint32_t block) const noexcept;
+
+    /**
+     * Checks the data is valid and sets up the record pointers.
+     * @returns True if it succeeds, false if it fails.
+     */
+    [[nodiscard]] bool validate() noexcept;
+
+    /**
+     * Gets a list of strings from the string reference table.
+     * @param range The range in the string reference table.
+     * @returns The strings.
+     */
+    [[nodiscard]] QList<QString> getStrings(const RangeRef& range) const noexcept;
+};
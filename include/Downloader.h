@@ -16,13 +16,15 @@
  */
 
 #include <QEventLoop>
-#include <QMutex>
+#include <QList>
 #include <QNetworkAccessManager>
+#include <QNetworkRequest>
 #include <QObject>
+#include <QSaveFile>
 #include <QTimer>
-#include <QWaitCondition>
 
-class Application;
+#include <memory>
+
 class QNetworkReply;
 
 class Downloader final : public QObject
@@ -32,13 +34,65 @@ class Downloader final : public QObject
 public:
     /**
      * Constructor
-     * @param setProgress (Optional) If non-null, the callback to signal download progress.
+     * @param setProgress (Optional) If non-null, the callback to signal the combined progress of all downloads.
+     * @param isCancelled (Optional) If non-null, the callback used while waiting to check whether all downloads should
+     *                    be abandoned.
      */
-    explicit Downloader(std::function<void(float)> setProgress = nullptr) noexcept;
+    explicit Downloader(
+        std::function<void(float)> setProgress = nullptr, std::function<bool()> isCancelled = nullptr) noexcept;
 
     /** Destructor */
     ~Downloader() noexcept override;
 
+    /**
+     * Starts downloading the url data in the background.
+     * @param url          URL of the resource.
+     * @param fileName     (Optional) If not empty, the file the data is written to as it arrives instead of being held
+     *                     in memory. The file is only replaced once the download has successfully completed.
+     * @param eTag         (Optional) The entity tag of the data the caller already has.
+     * @param lastModified (Optional) The last modified time of the data the caller already has.
+     * @returns The identifier used to wait on the download.
+     */
+    uint32_t add(const QUrl& url, const QString& fileName = QString(), const QByteArray& eTag = QByteArray(),
+        const QByteArray& lastModified = QByteArray()) noexcept;
+
+    /**
+     * Waits for a previously added download to complete. Other downloads continue while waiting. If cancelled while
+     * waiting then all outstanding downloads are aborted.
+     * @param id The identifier returned when the download was added.
+     * @returns True if it succeeds, false if it fails.
+     */
+    bool wait(uint32_t id) noexcept;
+
+    /**
+     * Waits for a previously added download to complete. Other downloads continue while waiting.
+     * @param       id      The identifier returned when the download was added.
+     * @param [out] retData Return used to pass back data from request.
+     * @returns True if it succeeds, false if it fails.
+     */
+    bool wait(uint32_t id, QByteArray& retData) noexcept;
+
+    /**
+     * Query if a completed download was skipped as the server reported the callers data is still current.
+     * @param id The identifier returned when the download was added.
+     * @returns True if not modified, false if not.
+     */
+    [[nodiscard]] bool isNotModified(uint32_t id) const noexcept;
+
+    /**
+     * Gets the entity tag returned by the server for a completed download.
+     * @param id The identifier returned when the download was added.
+     * @returns The entity tag, empty if none was provided.
+     */
+    [[nodiscard]] QByteArray getETag(uint32_t id) const noexcept;
+
+    /**
+     * Gets the last modified time returned by the server for a completed download.
+     * @param id The identifier returned when the download was added.
+     * @returns The last modified time, empty if none was provided.
+     */
+    [[nodiscard]] QByteArray getLastModified(uint32_t id) const noexcept;
+
     /**
      * Gets the url data.
      * @param       url     URL of the resource.
@@ -48,10 +102,39 @@ public:
     bool get(const QUrl& url, QByteArray& retData) noexcept;
 
 private:
+    /** A single in flight download */
+    struct Transfer
+    {
+        QNetworkRequest request;         /**< The request used for each attempt */
+        QNetworkReply* reply = nullptr;  /**< The reply of the current attempt */
+        QString fileName;                /**< The file to write the data to, empty to keep the data in memory */
+        std::unique_ptr<QSaveFile> file; /**< The file being written by the current attempt */
+        QTimer timer;                    /**< Timeout used to detect a stalled attempt */
+        uint32_t retries = 3;            /**< The number of remaining attempts */
+        bool finished = false;           /**< True once the download has completed or failed */
+        bool success = false;            /**< True if the download completed successfully */
+        bool notModified = false;        /**< True if the server reported the existing data as current */
+        QByteArray eTag;                 /**< The entity tag returned by the server */
+        QByteArray lastModified;         /**< The last modified time returned by the server */
+        QByteArray data;                 /**< The received data when not writing to a file */
+        qint64 received = 0;             /**< The number of bytes received by the current attempt */
+        qint64 total = 0;                /**< The expected number of bytes of the current attempt */
+    };
+
     QNetworkAccessManager* manager = nullptr;
     QEventLoop loop;
-    QTimer timer;
+    QTimer wakeTimer;
+    QList<std::shared_ptr<Transfer>> transfers;
     std::function<void(float)> callback;
+    std::function<bool()> cancelled;
+
+    void abortAll() noexcept;
+
+    void start(Transfer& transfer) noexcept;
+
+    void readyRead(Transfer& transfer) noexcept;
+
+    void finished(Transfer& transfer) noexcept;
 
-    void downloadProgress(qint64 bytesReceived, qint64 bytesTotal);
+    void downloadProgress(Transfer& transfer, qint64 bytesReceived, qint64 bytesTotal);
 };
@@ -0,0 +1,92 @@
+#pragma once
+/**
+ * Copyright Matthew Oliver
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Dataset.h"
+
+#include <QList>
+
+/** A set of intrinsics stored as a bitmap with one bit per intrinsic */
+using RowSet = QList<uint64_t>;
+
+/**
+ * Bitmap index of the intrinsics that have each technology, type and category.
+ * Used to count how many intrinsics each filter option would match by intersecting bitmaps instead of checking every
+ * intrinsic.
+ */
+class FacetIndex
+{
+public:
+    /** The groups of filter options */
+    enum class Facet
+    {
+        Technology,
+        Type,
+        Category,
+        Count
+    };
+
+    FacetIndex(const FacetIndex& other) = delete;
+
+    FacetIndex(FacetIndex&& other) noexcept = delete;
+
+    FacetIndex& operator=(const FacetIndex& other) = delete;
+
+    FacetIndex& operator=(FacetIndex&& other) noexcept = delete;
+
+    /**
+     * Constructor, builds the index for all intrinsics in the data.
+     * @param data The data to index.
+     */
+    explicit FacetIndex(const Dataset& data) noexcept;
+
+    /** Destructor. */
+    ~FacetIndex() noexcept = default;
+
+    /**
+     * Creates a set containing either all or none of the intrinsics.
+     * @param all True to include every intrinsic.
+     * @returns The new set.
+     */
+    [[nodiscard]] RowSet createSet(bool all) const noexcept;
+
+    /**
+     * Gets the intrinsics that match the checked options of a facet.
+     * @param facet   The facet.
+     * @param checked The checked options.
+     * @returns The intrinsics that have any of the checked options, or all intrinsics if none are checked.
+     */
+    [[nodiscard]] RowSet getMatches(Facet facet, const FilterMask& checked) const noexcept;
+
+    /**
+     * Counts the intrinsics that have each option of a facet.
+     * @param facet The facet.
+     * @param rows  The intrinsics to count.
+     * @returns The number of intrinsics in rows that have each option.
+     */
+    [[nodiscard]] QList<uint32_t> getCounts(Facet facet, const RowSet& rows) const noexcept;
+
+    /**
+     * Intersects 2 sets.
+     * @param [in,out] rows  The set to update.
+     * @param          other The set to intersect with.
+     */
+    static void intersect(RowSet& rows, const RowSet& other) noexcept;
+
+private:
+    qsizetype words = 0;                                   /**< The number of words in each set */
+    QList<RowSet> sets[static_cast<size_t>(Facet::Count)]; /**< The intrinsics of each option of each facet */
+};
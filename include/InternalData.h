@@ -15,10 +15,17 @@
  * limitations under the License.
  */
 
+#include <QByteArray>
 #include <QDate>
 #include <QList>
+#include <QMap>
 #include <QString>
 
+#include <bitset>
+
+/** A set of technologies, types or categories where each bit corresponds to an index into the list of all items */
+using FilterMask = std::bitset<128>;
+
 /** The uops measurements */
 class Measurements
 {
@@ -49,18 +56,6 @@ public:
     float throughput = 0;    /**< The measured throughput */
     uint32_t uops = 0;       /**< The instruction uops */
     QString ports;           /**< The instruction ports */
-
-    friend QDataStream& operator<<(QDataStream& out, const Measurements& other)
-    {
-        out << other.arch << other.latency << other.latencyMem << other.throughput << other.uops << other.ports;
-        return out;
-    }
-
-    friend QDataStream& operator>>(QDataStream& in, Measurements& other)
-    {
-        in >> other.arch >> other.latency >> other.latencyMem >> other.throughput >> other.uops >> other.ports;
-        return in;
-    }
 };
 
 Q_DECLARE_METATYPE(Measurements);
@@ -79,11 +74,11 @@ public:
 
     Instruction& operator=(Instruction&& other) noexcept = default;
 
-    Instruction(QString&& newFullName, QString&& newName, QString&& newDescription, QString&& newOperation,
+    Instruction(QString&& newSignature, QString&& newName, QString&& newDescription, QString&& newOperation,
         QString&& newHeader, QString&& newCpuidText, QString&& newTypeText, QString&& newCategoryText,
         QString&& newTechnology, QList<QString>&& newTypes, QList<QString>&& newCategories, QString&& newInstruction,
-        QList<Measurements>&& newMeasurements)
-        : fullName(std::forward<QString>(newFullName))
+        QList<QString>&& newXeds, QString&& newExtension)
+        : signature(std::forward<QString>(newSignature))
         , name(std::forward<QString>(newName))
         , description(std::forward<QString>(newDescription))
         , operation(std::forward<QString>(newOperation))
@@ -95,10 +90,11 @@ public:
         , types(std::forward<QStringList>(newTypes))
         , categories(std::forward<QStringList>(newCategories))
         , instruction(std::forward<QString>(newInstruction))
-        , measurements(std::forward<QList<Measurements>>(newMeasurements))
+        , xeds(std::forward<QStringList>(newXeds))
+        , extension(std::forward<QString>(newExtension))
     {}
 
-    QString fullName;                 /**< Intrinsics name combined with return and parameters */
+    QString signature;                /**< The return and parameter types and names, see SignatureFormatter */
     QString name;                     /**< The intrinsics name */
     QString description;              /**< The description */
     QString operation;                /**< The pseudo code operation */
@@ -110,6 +106,8 @@ public:
     QList<QString> types;             /**< The types of data the intrinsic operates on (e.g. Integer/Float etc.) */
     QList<QString> categories;        /**< The category of operation (e.g. Arithmetic etc.) */
     QString instruction;              /**< The intrinsics assembly equivalent */
+    QList<QString> xeds;              /**< The xed instruction forms used to look up the uops measurements */
+    QString extension;                /**< The uops extension the instruction is expected to be listed under */
     QList<Measurements> measurements; /**< The list of measurements */
 };
 
@@ -126,11 +124,11 @@ public:
 
     InstructionIndexed& operator=(InstructionIndexed&& other) noexcept = default;
 
-    InstructionIndexed(QString&& newFullName, QString&& newName, QString&& newDescription, QString&& newOperation,
+    InstructionIndexed(QString&& newSignature, QString&& newName, QString&& newDescription, QString&& newOperation,
         QString&& newHeader, QString&& newCpuidText, QString&& newTypeText, QString&& newCategoryText,
         const uint32_t newTechnology, QList<uint32_t>&& newTypes, QList<uint32_t>&& newCategories,
         QString&& newInstruction, QList<Measurements>&& newMeasurements)
-        : fullName(std::forward<QString>(newFullName))
+        : signature(std::forward<QString>(newSignature))
         , name(std::forward<QString>(newName))
         , description(std::forward<QString>(newDescription))
         , operation(std::forward<QString>(newOperation))
@@ -145,7 +143,7 @@ public:
         , measurements(std::forward<QList<Measurements>>(newMeasurements))
     {}
 
-    QString fullName;           /**< Intrinsics name combined with return and parameters */
+    QString signature;          /**< The return and parameter types and names, see SignatureFormatter */
     QString name;               /**< The intrinsics name */
     QString description;        /**< The description */
     QString operation;          /**< The pseudo code operation */
@@ -159,22 +157,6 @@ public:
     QString instruction;        /**< The intrinsics assembly equivalent */
     QList<Measurements> measurements; /**< The list of measurements */
 
-    friend QDataStream& operator<<(QDataStream& out, const InstructionIndexed& other)
-    {
-        out << other.fullName << other.name << other.description << other.operation << other.header << other.cpuidText
-            << other.typeText << other.categoryText << other.technology << other.types << other.categories
-            << other.instruction << other.measurements;
-        return out;
-    }
-
-    friend QDataStream& operator>>(QDataStream& in, InstructionIndexed& other)
-    {
-        in >> other.fullName >> other.name >> other.description >> other.operation >> other.header >> other.cpuidText >>
-            other.typeText >> other.categoryText >> other.technology >> other.types >> other.categories >>
-            other.instruction >> other.measurements;
-        return in;
-    }
-
     friend bool operator<(const InstructionIndexed& left, const InstructionIndexed& right)
     {
         return left.name < right.name;
@@ -183,6 +165,31 @@ public:
 
 Q_DECLARE_METATYPE(InstructionIndexed);
 
+/** The HTTP validators of an upstream data source */
+class SourceValidator
+{
+public:
+    SourceValidator() noexcept = default;
+
+    SourceValidator(const SourceValidator& other) noexcept = default;
+
+    SourceValidator(SourceValidator&& other) noexcept = default;
+
+    SourceValidator& operator=(const SourceValidator& other) noexcept = default;
+
+    SourceValidator& operator=(SourceValidator&& other) noexcept = default;
+
+    SourceValidator(QByteArray&& newETag, QByteArray&& newLastModified)
+        : eTag(std::forward<QByteArray>(newETag))
+        , lastModified(std::forward<QByteArray>(newLastModified))
+    {}
+
+    QByteArray eTag;         /**< The entity tag of the last downloaded data */
+    QByteArray lastModified; /**< The last modified time of the last downloaded data */
+};
+
+Q_DECLARE_METATYPE(SourceValidator);
+
 class InternalData
 {
 public:
@@ -196,24 +203,37 @@ public:
 
     InternalData& operator=(InternalData&& other) noexcept = default;
 
-    QList<QString> allTechnologies;         /**< The list of all known intrinsic technologies */
-    QList<QString> allTypes;                /**< The list of all known intrinsic types */
-    QList<QString> allCategories;           /**< The list of all known intrinsic categories */
-    QList<InstructionIndexed> instructions; /**< The list of all known intrinsics */
-    QString version;                        /**< The intrinsic list version */
-    QDate date;                             /**< The intrinsic list date */
-
-    friend QDataStream& operator<<(QDataStream& out, const InternalData& other)
+    /**
+     * Gets the display name of each element type used by the intrinsic guide.
+     * @returns The display names keyed by element type (e.g. FP32).
+     */
+    [[nodiscard]] static const QMap<QString, QString>& getTypeNames() noexcept
     {
-        out << other.allTechnologies << other.allTypes << other.allCategories << other.instructions << other.version;
-        return out;
+        static const QMap<QString, QString> typeNames = {
+            {"BF16",                     "BFloat16"},
+            {"FP16",               "Float16 (half)"},
+            {"FP32",              "Float32 (float)"},
+            {"FP64",             "Float64 (double)"},
+            {"MASK",                         "Mask"},
+            {"SI16",    "Integer Signed 16 (int16)"},
+            {"SI32",    "Integer Signed 32 (int32)"},
+            {"SI64",    "Integer Signed 64 (int64)"},
+            { "SI8",      "Integer Signed 8 (int8)"},
+            {"UI16", "Integer Unsigned 16 (uint16)"},
+            {"UI32", "Integer Unsigned 32 (uint32)"},
+            {"UI64", "Integer Unsigned 64 (uint64)"},
+            { "UI8",   "Integer Unsigned 8 (uint8)"}
+        };
+        return typeNames;
     }
 
-    friend QDataStream& operator>>(QDataStream& in, InternalData& other)
-    {
-        in >> other.allTechnologies >> other.allTypes >> other.allCategories >> other.instructions >> other.version;
-        return in;
-    }
+    QList<QString> allTechnologies;            /**< The list of all known intrinsic technologies */
+    QList<QString> allTypes;                   /**< The list of all known intrinsic types */
+    QList<QString> allCategories;              /**< The list of all known intrinsic categories */
+    QList<InstructionIndexed> instructions;    /**< The list of all known intrinsics */
+    QString version;                           /**< The intrinsic list version */
+    QDate date;                                /**< The intrinsic list date */
+    QMap<QString, SourceValidator> validators; /**< The validators of each upstream source keyed by url */
 };
 
 Q_DECLARE_METATYPE(InternalData);
@@ -242,6 +262,7 @@ public:
 
     QString name;
     bool checked = false;
+    uint32_t count = 0;
 };
 
 Q_DECLARE_METATYPE(StringChecked);
@@ -15,48 +15,14 @@
  * limitations under the License.
  */
 
-#include "InternalData.h"
+#include "Dataset.h"
+#include "SignatureFormatter.h"
 
 #include <QAbstractListModel>
+#include <QHash>
 
 class MeasurementModel;
 
-class InstructionModeled
-{
-public:
-    friend class IntrinsicModel;
-
-    InstructionModeled(const InstructionModeled& other) noexcept = default;
-
-    InstructionModeled(InstructionModeled&& other) noexcept = default;
-
-    InstructionModeled& operator=(const InstructionModeled& other) noexcept = default;
-
-    InstructionModeled& operator=(InstructionModeled&& other) noexcept = default;
-
-    InstructionModeled(InstructionIndexed&& base, QObject* parent);
-
-    ~InstructionModeled() noexcept = default;
-
-private:
-    QString fullName;           /**< Intrinsics name combined with return and parameters */
-    QString name;               /**< The intrinsics name */
-    QString description;        /**< The description */
-    QString operation;          /**< The pseudo code operation */
-    QString header;             /**< The instructions required include header */
-    QString cpuidText;          /**< The required CPUID`s as user readable text */
-    QString typeText;           /**< The required types as user readable text */
-    QString categoryText;       /**< The categories of operation as user readable text */
-    uint32_t technology = 0;    /**< The required technology (e.g. AVX etc.). Indexes into allTechnologies */
-    QList<uint32_t> types;      /**< The data types operated on (e.g. Integer/Float etc.). Indexes into allTypes */
-    QList<uint32_t> categories; /**< The category of operation (e.g. Arithmetic etc.). Indexes into allCategories */
-    QString instruction;        /**< The intrinsics assembly equivalent */
-    std::shared_ptr<MeasurementModel> measurements; /**< The list of measurements */
-    bool expanded = false;                          /**< Buffer use to cache Qt expanded/collapsed state */
-};
-
-Q_DECLARE_METATYPE(InstructionModeled);
-
 class IntrinsicModel final : public QAbstractListModel
 {
     Q_OBJECT
@@ -141,12 +107,65 @@ public:
      */
     bool setData(const QModelIndex& index, const QVariant& value, int role) noexcept override;
 
+    /**
+     * Sets the colours used to style the signatures and descriptions.
+     * @param type The colour of types.
+     * @param name The colour of variable names.
+     */
+    Q_INVOKABLE void setSignatureColours(const QString& type, const QString& name) noexcept;
+
     /**
      * Loads this model.
-     * @param [in,out] data The data to load.
+     * @param data The data to load.
+     */
+    void load(const std::shared_ptr<Dataset>& data) noexcept;
+
+    /**
+     * Replaces the data used by this model without resetting it, any expanded intrinsics remain expanded.
+     * @param data The data to load.
+     * @note Existing rows are updated in place with only the change in row count being removed or inserted.
+     */
+    void update(const std::shared_ptr<Dataset>& data) noexcept;
+
+    /**
+     * Gets the technology of an intrinsic.
+     * @param row The row of the intrinsic.
+     * @returns The technology index.
      */
-    void load(QList<InstructionIndexed>& data) noexcept;
+    [[nodiscard]] uint32_t getTechnology(qsizetype row) const noexcept;
+
+    /**
+     * Gets the types of an intrinsic.
+     * @param row The row of the intrinsic.
+     * @returns The type mask.
+     */
+    [[nodiscard]] const FilterMask& getTypeMask(qsizetype row) const noexcept;
+
+    /**
+     * Gets the categories of an intrinsic.
+     * @param row The row of the intrinsic.
+     * @returns The category mask.
+     */
+    [[nodiscard]] const FilterMask& getCategoryMask(qsizetype row) const noexcept;
 
 private:
-    QList<InstructionModeled> instructions; /**< The list of all known intrinsics */
+    std::shared_ptr<Dataset> dataset; /**< The data that all intrinsics are read from */
+    mutable QHash<qsizetype, std::shared_ptr<MeasurementModel>> measurements; /**< Measurements of displayed rows */
+    mutable QList<std::shared_ptr<MeasurementModel>> measurementPool; /**< Unused measurement models to reuse */
+    QList<bool> expanded; /**< Buffer use to cache Qt expanded/collapsed state */
+    mutable SignatureFormatter formatter; /**< Formats the styled signatures and descriptions */
+    QList<FilterMask> typeMasks; /**< The types of each intrinsic as a mask */
+    QList<FilterMask> categoryMasks; /**< The categories of each intrinsic as a mask */
+
+    /**
+     * Updates the type and category masks of an intrinsic from the current data.
+     * @param row The row of the intrinsic.
+     */
+    void updateMasks(qsizetype row) noexcept;
+
+    /**
+     * Releases the measurement model of an intrinsic so that it can be reused by another.
+     * @param row The row of the intrinsic.
+     */
+    void releaseMeasurements(qsizetype row) noexcept;
 };
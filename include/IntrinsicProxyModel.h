@@ -15,14 +15,25 @@
  * limitations under the License.
  */
 
+#include "FacetIndex.h"
 #include "InternalData.h"
+#include "PerformanceIndex.h"
+#include "SearchIndex.h"
 
+#include <QFutureWatcher>
 #include <QSortFilterProxyModel>
+#include <QTimer>
+
+#include <functional>
 
 class IntrinsicProxyModel final : public QSortFilterProxyModel
 {
     Q_OBJECT
 
+    Q_PROPERTY(QList<QString> architectures READ getArchitectures NOTIFY architecturesChanged)
+
+    Q_PROPERTY(int architecture READ getArchitecture NOTIFY architecturesChanged)
+
 public:
     /**
      * Constructor.
@@ -50,29 +61,147 @@ public:
 
     /**
      * Loads this model.
-     * @param [in,out] technologies The data to load.
-     * @param [in,out] types The data to load.
-     * @param [in,out] categories The data to load.
+     * @param technologies The checked technologies.
+     * @param types        The checked types.
+     * @param categories   The checked categories.
      * @note This is used to force the model to update all data. This must be run from the primary thread.
      */
-    void load(const QList<StringChecked>& technologies, const QList<StringChecked>& types,
-        const QList<StringChecked>& categories) noexcept;
+    void load(const FilterMask& technologies, const FilterMask& types, const FilterMask& categories) noexcept;
 
-    /** Signal that the filter need to be updated */
+    /**
+     * Signal that the filter need to be updated.
+     * @note The update is deferred until control returns to the event loop so that any number of changes made
+     * together only refilter the model once.
+     */
     Q_SLOT void filterUpdated();
 
+    /**
+     * Updates the cached checked state after the filter lists have been updated.
+     * @note Unlike filterUpdated this does not refilter the model, rows are instead filtered as the source changes.
+     */
+    void checkedUpdated() noexcept;
+
+    /**
+     * Sets the index used to search the intrinsics.
+     * @param index The search index of the new data.
+     * @param apply (Optional) Called once the new index is used, this should swap the new data into the source model.
+     * @note Any current search is first repeated against the new index in the background. The new data and its search
+     * matches are then applied together so that rows are never filtered using the matches of other data.
+     */
+    void setSearchIndex(const std::shared_ptr<SearchIndex>& index, std::function<void()> apply = {}) noexcept;
+
+    /**
+     * Sets the index used to sort and filter the intrinsics by their measurements.
+     * @param index The performance index of the current data.
+     * @note This does not refilter the model, rows are instead filtered as the source changes.
+     */
+    void setPerformanceIndex(const std::shared_ptr<PerformanceIndex>& index) noexcept;
+
+    /**
+     * Sets the index used to count the intrinsics that match each filter option.
+     * @param index The facet index of the current data.
+     * @note The counts are not updated until updateFacetCounts is called.
+     */
+    void setFacetIndex(const std::shared_ptr<FacetIndex>& index) noexcept;
+
+    /**
+     * Recounts the intrinsics that each filter option would match.
+     * @note Each option is counted against the other current filters so that the count is the number of intrinsics
+     * that would be shown if only that option were checked in its own group.
+     */
+    void updateFacetCounts() noexcept;
+
+    /**
+     * Notify that the number of intrinsics matching each filter option has changed.
+     * @param technologies The count for each technology.
+     * @param types        The count for each type.
+     * @param categories   The count for each category.
+     */
+    Q_SIGNAL void facetCountsChanged(
+        const QList<uint32_t>& technologies, const QList<uint32_t>& types, const QList<uint32_t>& categories) const;
+
+    /**
+     * Gets the names of all measured architectures.
+     * @returns The architecture names.
+     */
+    [[nodiscard]] QList<QString> getArchitectures() const noexcept;
+
+    /**
+     * Gets the selected architecture.
+     * @returns Zero-based index of the architecture, -1 if none is selected.
+     */
+    [[nodiscard]] int getArchitecture() const noexcept;
+
+    /** Notify that the list of architectures or the selected architecture has changed. */
+    Q_SIGNAL void architecturesChanged() const;
+
+    /**
+     * Selects the architecture used for sorting, only intrinsics measured on the architecture are then shown.
+     * @param arch Zero-based index of the architecture, -1 to show all intrinsics.
+     */
+    Q_INVOKABLE void setArchitecture(int arch) noexcept;
+
+    /**
+     * Sets the measurement used to sort intrinsics on the selected architecture.
+     * @param metric The PerformanceIndex::Metric to sort by, -1 to sort by name.
+     */
+    Q_INVOKABLE void setSortMetric(int metric) noexcept;
+
     /**
      * Sets filter expression from search box.
      * @param filter Specifies the filter.
+     * @note The search is performed in the background and applied once complete.
      */
     Q_SLOT void setFilterExpression(const QString& filter);
 
 private:
-    const QList<StringChecked>* allTechnologies = nullptr; /**< The list of all known intrinsic technologies */
-    const QList<StringChecked>* allTypes = nullptr;        /**< The list of all known intrinsic types */
-    const QList<StringChecked>* allCategories = nullptr;   /**< The list of all known intrinsic categories */
-    bool noTechChecked = true;                             /**< True if no technologies are checked */
-    bool noTypeChecked = true;                             /**< True if no types are checked */
-    bool noCatsChecked = true;                             /**< True if no categories are checked */
-    QString search;                                        /**< The search string */
+    /** Updates the cached columns for the selected architecture and sort metric. */
+    void updateColumns() noexcept;
+
+    /** Refilters the model after the checked filters have changed. */
+    void applyFilter() noexcept;
+
+    /** Discards the result of any running search and stops it as soon as possible. */
+    void cancelSearch() noexcept;
+
+    /** Starts searching for the most recently requested search string. */
+    void startSearch() noexcept;
+
+    /** Applies the result of a completed search. */
+    void finishSearch() noexcept;
+
+    /**
+     * Updates the rows that match the search string.
+     * @param rows The sorted indexes of each matching source row.
+     */
+    void updateMatches(const QList<uint32_t>& rows) noexcept;
+
+    const FilterMask* checkedTechnologies = nullptr;    /**< The checked intrinsic technologies */
+    const FilterMask* checkedTypes = nullptr;           /**< The checked intrinsic types */
+    const FilterMask* checkedCategories = nullptr;      /**< The checked intrinsic categories */
+    bool noTechChecked = true;                          /**< True if no technologies are checked */
+    bool noTypeChecked = true;                          /**< True if no types are checked */
+    bool noCatsChecked = true;                          /**< True if no categories are checked */
+    QString search;                                     /**< The search string */
+    std::shared_ptr<SearchIndex> searchIndex;           /**< The search index of the source data */
+    QList<bool> searchMatches;                          /**< True for each source row that matches the search string */
+    RowSet searchRows;                                  /**< The source rows that match the search string */
+    std::shared_ptr<PerformanceIndex> performanceIndex; /**< The performance index of the source data */
+    QString architecture;                               /**< The name of the selected architecture, empty if none */
+    qsizetype archIndex = -1;                           /**< The selected architecture in the performance index */
+    int sortMetric = -1;                                /**< The metric to sort by, -1 to sort by name */
+    const float* sortColumn = nullptr;                  /**< The sort metric of the selected architecture */
+    const float* measuredColumn = nullptr;              /**< NaN for each intrinsic not measured on the architecture */
+    RowSet measuredRows;                                /**< The source rows measured on the selected architecture */
+    std::shared_ptr<FacetIndex> facetIndex;             /**< The facet index of the source data */
+    QString pendingSearch;                              /**< The most recently requested search string */
+    QString runningSearch;                              /**< The search string of the running search */
+    uint32_t searchGeneration = 0;                      /**< Incremented whenever the requested search changes */
+    uint32_t runningGeneration = 0;                     /**< The search generation of the running search */
+    QTimer searchTimer;                                 /**< Delays searching until typing pauses */
+    QFutureWatcher<QList<uint32_t>> searchWatcher;      /**< Watches the running search */
+    std::shared_ptr<std::atomic_bool> searchCancelled;  /**< Set to stop the running search once it is out of date */
+    bool filterPending = false;                         /**< True if a filter update has been scheduled */
+    std::shared_ptr<SearchIndex> pendingIndex;          /**< The new search index waiting on its search to complete */
+    std::function<void()> pendingApply;                 /**< Applies the data of the pending search index */
 };
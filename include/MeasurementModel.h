@@ -15,7 +15,7 @@
  * limitations under the License.
  */
 
-#include "InternalData.h"
+#include "Dataset.h"
 
 #include <QAbstractTableModel>
 
@@ -40,10 +40,11 @@ public:
 
     /**
      * Constructor.
-     * @param [in,out] data   The data to load.
-     * @param [in]     parent (Optional) If non-null, the parent.
+     * @param      data        The data to read from.
+     * @param      instruction Zero-based index of the intrinsic whose measurements are displayed.
+     * @param [in] parent      (Optional) If non-null, the parent.
      */
-    explicit MeasurementModel(QList<Measurements>&& data, QObject* parent = nullptr) noexcept;
+    MeasurementModel(std::shared_ptr<Dataset> data, uint32_t instruction, QObject* parent = nullptr) noexcept;
 
     /** Destructor. */
     ~MeasurementModel() override = default;
@@ -84,6 +85,15 @@ public:
      */
     [[nodiscard]] QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const noexcept override;
 
+    /**
+     * Changes the intrinsic whose measurements are displayed.
+     * @param data        The data to read from.
+     * @param instruction Zero-based index of the intrinsic whose measurements are displayed.
+     * @note This allows an existing model to be reused instead of creating a new one.
+     */
+    void setInstruction(std::shared_ptr<Dataset> data, uint32_t instruction) noexcept;
+
 private:
-    QList<Measurements> measurements; /**< The list of all measurements */
+    std::shared_ptr<Dataset> dataset; /**< The data that the measurements are read from */
+    Dataset::RangeRef measurements;   /**< The range of measurement records */
 };
@@ -0,0 +1,82 @@
+#pragma once
+/**
+ * Copyright Matthew Oliver
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Dataset.h"
+
+#include <QList>
+#include <QString>
+
+/**
+ * Columnar index of the uops measurements of each intrinsic.
+ * For every architecture each metric is stored as a column holding one value per intrinsic so that the intrinsics can
+ * be filtered and sorted by a metric without reading the measurement records.
+ */
+class PerformanceIndex
+{
+public:
+    /** The measured values that can be looked up */
+    enum class Metric
+    {
+        Latency,
+        LatencyMem,
+        Throughput,
+        Uops,
+        Count
+    };
+
+    PerformanceIndex(const PerformanceIndex& other) = delete;
+
+    PerformanceIndex(PerformanceIndex&& other) noexcept = delete;
+
+    PerformanceIndex& operator=(const PerformanceIndex& other) = delete;
+
+    PerformanceIndex& operator=(PerformanceIndex&& other) noexcept = delete;
+
+    /**
+     * Constructor, builds the index for all intrinsics in the data.
+     * @param data The data to index.
+     */
+    explicit PerformanceIndex(const Dataset& data) noexcept;
+
+    /** Destructor. */
+    ~PerformanceIndex() noexcept = default;
+
+    /**
+     * Gets the names of all measured architectures.
+     * @returns The sorted architecture names.
+     */
+    [[nodiscard]] const QList<QString>& getArchitectures() const noexcept;
+
+    /**
+     * Gets the values of a metric for every intrinsic.
+     * @param arch   Zero-based index of the architecture.
+     * @param metric The metric.
+     * @returns The column of values indexed by intrinsic, NaN for any intrinsic without a known value.
+     */
+    [[nodiscard]] const float* getColumn(qsizetype arch, Metric metric) const noexcept;
+
+    /**
+     * Gets the number of indexed intrinsics.
+     * @returns The intrinsic count.
+     */
+    [[nodiscard]] qsizetype getCount() const noexcept;
+
+private:
+    QList<QString> architectures; /**< The measured architectures */
+    QList<float> values;          /**< The columns of each architecture and metric */
+    qsizetype count = 0;          /**< The number of intrinsics in each column */
+};
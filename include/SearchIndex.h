@@ -0,0 +1,115 @@
+#pragma once
+/**
+ * Copyright Matthew Oliver
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Dataset.h"
+
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QString>
+
+#include <atomic>
+#include <memory>
+
+/**
+ * Trigram index used to search the text of each intrinsic.
+ * Every lower case 3 character sequence of the name, instruction, CPUID and plain text description of each intrinsic
+ * maps to the list of intrinsics that contain it so that a search only needs to check the intrinsics that contain every
+ * trigram of the words in the search string. The descriptions are compressed in the data so they are only indexed once
+ * they are first searched, the matching intrinsics are then checked directly against the data.
+ */
+class SearchIndex
+{
+public:
+    SearchIndex(const SearchIndex& other) = delete;
+
+    SearchIndex(SearchIndex&& other) noexcept = delete;
+
+    SearchIndex& operator=(const SearchIndex& other) = delete;
+
+    SearchIndex& operator=(SearchIndex&& other) noexcept = delete;
+
+    /**
+     * Constructor, builds the index of the name, instruction and CPUID of all intrinsics in the data.
+     * @param data The data to index.
+     */
+    explicit SearchIndex(std::shared_ptr<Dataset> data) noexcept;
+
+    /** Destructor. */
+    ~SearchIndex() noexcept = default;
+
+    /**
+     * Finds all intrinsics that match a search string, ignoring case.
+     * @param search    The string to search for, see SearchQuery for the supported syntax.
+     * @param cancelled (Optional) If non-null, the flag that is set to stop the search early.
+     * @returns The sorted indexes of each matching intrinsic, empty if cancelled.
+     * @note The first search containing a word also indexes the descriptions so should not be run on the GUI thread.
+     */
+    [[nodiscard]] QList<uint32_t> find(
+        const QString& search, const std::atomic_bool* cancelled = nullptr) const noexcept;
+
+    /**
+     * Gets the number of indexed intrinsics.
+     * @returns The intrinsic count.
+     */
+    [[nodiscard]] uint32_t getCount() const noexcept;
+
+private:
+    using TrigramMap = QHash<uint64_t, QList<uint32_t>>;
+
+    std::shared_ptr<Dataset> dataset;         /**< The indexed data */
+    TrigramMap trigrams;                      /**< The sorted intrinsics with each trigram in a name/mnemonic/CPUID */
+    mutable TrigramMap descriptionTrigrams;   /**< The sorted intrinsics with each trigram in their description */
+    mutable bool descriptionsIndexed = false; /**< True once the description trigrams have been built */
+    mutable QMutex descriptionMutex;          /**< Guards building the description trigrams */
+
+    /**
+     * Gets the key of the trigram starting at a character.
+     * @param chars The first character of the trigram.
+     * @returns The key.
+     */
+    [[nodiscard]] static uint64_t getTrigram(const QChar* chars) noexcept;
+
+    /**
+     * Adds every trigram of a text to a trigram map.
+     * @param [in,out] map  The map to add to.
+     * @param          text The text, this is converted to lower case.
+     * @param          row  Zero-based index of the intrinsic, must not be less than any previously added.
+     */
+    static void addTrigrams(TrigramMap& map, QStringView text, uint32_t row) noexcept;
+
+    /**
+     * Builds the description trigrams if they have not already been built.
+     * @param cancelled (Optional) If non-null, the flag that is set to stop indexing early.
+     * @returns True if the descriptions are indexed, false if cancelled.
+     */
+    bool indexDescriptions(const std::atomic_bool* cancelled) const noexcept;
+
+    /**
+     * Gets the intrinsics that contain a trigram in any of their searchable text.
+     * @param chars The first character of the trigram.
+     * @returns The sorted intrinsics.
+     */
+    [[nodiscard]] QList<uint32_t> getRows(const QChar* chars) const noexcept;
+
+    /**
+     * Reduces a list of candidate intrinsics to those that contain every trigram of a word.
+     * @param          word       The lower case word, must be at least 3 characters long.
+     * @param [in,out] candidates The sorted candidates.
+     */
+    void filterCandidates(const QString& word, QList<uint32_t>& candidates) const noexcept;
+};
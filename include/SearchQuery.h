@@ -0,0 +1,117 @@
+#pragma once
+/**
+ * Copyright Matthew Oliver
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Dataset.h"
+
+#include <QList>
+#include <QString>
+
+/**
+ * A search string compiled into a set of terms that must all match an intrinsic.
+ * Terms are separated by spaces and any term can be negated by prefixing it with '!'. Values containing spaces can be
+ * quoted. Supported terms are:
+ *  - tech:X, type:X, cat:X Matches the technology, type or category named X. If no name matches exactly then any name
+ *                          containing X is matched. Types can also be given by element type (e.g. type:FP32).
+ *  - name:X, mnemonic:X    Matches intrinsic names or instructions containing X.
+ *  - lat, latmem, tp, uops Compares the latency, memory latency, throughput or uops of any measurement to a number
+ *                          using one of <, <=, =, >=, >. The measurements can be limited to a single architecture by
+ *                          appending @Arch (e.g. lat<=4@Zen4).
+ *  - port:X                Matches any measurement that uses port X (e.g. port:p5), also supports @Arch.
+ *  - Anything else is searched for in the intrinsics name, instruction, CPUID and description.
+ */
+class SearchQuery
+{
+public:
+    /**
+     * Constructor, compiles a search string.
+     * @param search The search string.
+     * @param data   The data the search will be run against.
+     */
+    SearchQuery(const QString& search, const Dataset& data) noexcept;
+
+    /**
+     * Gets the lower case words that must be found in the searchable text of a matching intrinsic.
+     * @returns The words.
+     */
+    [[nodiscard]] const QList<QString>& getWords() const noexcept;
+
+    /**
+     * Checks whether an intrinsic matches all terms.
+     * @param data  The data the query was compiled against.
+     * @param index Zero-based index of the intrinsic.
+     * @returns True if it matches, false if it does not.
+     * @note The description is only read for text terms not found in any of the other searchable fields.
+     */
+    [[nodiscard]] bool matches(const Dataset& data, uint32_t index) const noexcept;
+
+private:
+    enum class Field
+    {
+        Text,
+        Technology,
+        Type,
+        Category,
+        Name,
+        Instruction,
+        Latency,
+        LatencyMem,
+        Throughput,
+        Uops,
+        Port
+    };
+
+    enum class Compare
+    {
+        Less,
+        LessEqual,
+        Equal,
+        GreaterEqual,
+        Greater
+    };
+
+    /** A single compiled term */
+    struct Term
+    {
+        Field field = Field::Text;        /**< The field the term checks */
+        bool negate = false;              /**< True if the result of the term is inverted */
+        FilterMask mask;                  /**< The matching technologies, types or categories */
+        QString value;                    /**< The lower case text to find or the port name prefix */
+        QString digits;                   /**< The port numbers */
+        Compare compare = Compare::Equal; /**< The comparison used for numeric fields */
+        float number = 0.0F;              /**< The number compared against */
+        QString arch;                     /**< The architecture to limit measurements to, empty for all */
+    };
+
+    QList<Term> terms;    /**< The terms that must all match */
+    QList<QString> words; /**< The lower case text that must be found */
+
+    /**
+     * Compiles a single term.
+     * @param token The term text.
+     * @param data  The data the search will be run against.
+     */
+    void addTerm(QString token, const Dataset& data) noexcept;
+
+    /**
+     * Checks whether an intrinsic matches a term, ignoring negation.
+     * @param term  The term to check.
+     * @param data  The data the query was compiled against.
+     * @param index Zero-based index of the intrinsic.
+     * @returns True if it matches, false if it does not.
+     */
+    [[nodiscard]] static bool matchesTerm(const Term& term, const Dataset& data, uint32_t index) noexcept;
+};
@@ -0,0 +1,105 @@
+#pragma once
+/**
+ * Copyright Matthew Oliver
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <QList>
+#include <QPair>
+#include <QString>
+
+/**
+ * Formats the styled signature and description of an intrinsic for display.
+ * The data only stores the signature as its individual parts so that the styling is only applied when displayed,
+ * recently formatted text is cached as the same intrinsics are repeatedly displayed while scrolling.
+ */
+class SignatureFormatter
+{
+public:
+    SignatureFormatter(const SignatureFormatter& other) = delete;
+
+    SignatureFormatter(SignatureFormatter&& other) noexcept = delete;
+
+    SignatureFormatter& operator=(const SignatureFormatter& other) = delete;
+
+    SignatureFormatter& operator=(SignatureFormatter&& other) noexcept = delete;
+
+    /** Default constructor. */
+    SignatureFormatter() noexcept = default;
+
+    /** Destructor. */
+    ~SignatureFormatter() noexcept = default;
+
+    /**
+     * Converts the parts of a signature into the stored format.
+     * @param returnType The return type.
+     * @param returnName The name of the return variable.
+     * @param parameters The type and name of each parameter.
+     * @returns The stored signature.
+     */
+    [[nodiscard]] static QString encode(const QString& returnType, const QString& returnName,
+        const QList<QPair<QString, QString>>& parameters) noexcept;
+
+    /**
+     * Sets the colours used to style types and variable names.
+     * @param type The colour of types.
+     * @param name The colour of variable names.
+     * @note Any cached text is discarded.
+     */
+    void setColours(const QString& type, const QString& name) noexcept;
+
+    /**
+     * Formats the signature of an intrinsic.
+     * @param row       The row of the intrinsic, used to look up previously formatted text.
+     * @param name      The intrinsic name.
+     * @param signature The stored signature.
+     * @returns The styled signature.
+     */
+    [[nodiscard]] QString formatSignature(uint32_t row, QStringView name, const QString& signature) noexcept;
+
+    /**
+     * Formats the description of an intrinsic by styling any quoted variable names.
+     * @param row         The row of the intrinsic, used to look up previously formatted text.
+     * @param signature   The stored signature.
+     * @param description The plain text description.
+     * @returns The styled description.
+     */
+    [[nodiscard]] QString formatDescription(
+        uint32_t row, const QString& signature, const QString& description) noexcept;
+
+    /** Discards all cached text, this must be called whenever the rows change. */
+    void clear() noexcept;
+
+private:
+    QString typeColour = "mediumpurple";              /**< The colour of types */
+    QString nameColour = "lightseagreen";             /**< The colour of variable names */
+    QList<QPair<uint32_t, QString>> signatureCache;   /**< Recently formatted signatures, most recent last */
+    QList<QPair<uint32_t, QString>> descriptionCache; /**< Recently formatted descriptions, most recent last */
+
+    /**
+     * Gets previously formatted text.
+     * @param cache The cache to search.
+     * @param row   The row of the intrinsic.
+     * @returns The text if found, a null string otherwise.
+     */
+    [[nodiscard]] static QString find(QList<QPair<uint32_t, QString>>& cache, uint32_t row) noexcept;
+
+    /**
+     * Adds formatted text to a cache, replacing the least recently used text if full.
+     * @param cache The cache to add to.
+     * @param row   The row of the intrinsic.
+     * @param text  The formatted text.
+     */
+    static void insert(QList<QPair<uint32_t, QString>>& cache, uint32_t row, const QString& text) noexcept;
+};
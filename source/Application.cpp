@@ -36,7 +36,7 @@ Application::Application(int argc, char* argv[], QObject* parent) noexcept
 
 Application::~Application() noexcept
 {
-    loaded = true; // Use loaded to shutdown any running data init
+    shutdown = true; // Shutdown any running data init
     if (dataLoad.get() != nullptr) {
         dataLoad->waitForFinished();
     }
@@ -80,23 +80,23 @@ int Application::run() noexcept
 
 void Application::resetData() noexcept
 {
-    // Delete old cache
-    if (QFile fileCache("./dataCache"); fileCache.exists()) {
-        fileCache.remove();
+    // Only a single update can run at a time and never before the initial data is loaded
+    if (!loaded || refreshing || dataLoad != nullptr) {
+        return;
     }
+    startUpdate();
+}
 
-    setLoadingTitle("Reloading...");
-    setProgress(0.0F);
-    setLoaded(false);
+void Application::startUpdate() noexcept
+{
+    setRefreshing(true);
 
-    // Queue up the model initialisation
+    // The existing data remains in use while upstream is checked for changes
     dataLoad = std::make_unique<QFuture<bool>>();
     watcher = std::make_unique<QFutureWatcher<bool>>();
-    connect(watcher.get(), &QFutureWatcher<bool>::finished, this, &Application::setupData);
-    QTimer::singleShot(1000, [this] {
-        *dataLoad = QtConcurrent::run([this] { return provider.setup(); });
-        watcher->setFuture(*dataLoad);
-    });
+    connect(watcher.get(), &QFutureWatcher<bool>::finished, this, &Application::updateData);
+    *dataLoad = QtConcurrent::run([this] { return provider.update(); });
+    watcher->setFuture(*dataLoad);
 }
 
 void Application::addOKDialog(const QString& title, const std::function<void()>& callback)
@@ -153,6 +153,10 @@ float Application::getProgress() const noexcept
 
 void Application::setProgress(const float newProgress) noexcept
 {
+    // Progress of a background update is not displayed as it would hide the already loaded data
+    if (refreshing) {
+        return;
+    }
     progress = fmin(fabs(newProgress), 1.0F);
     emit notifyProgressChanged();
 }
@@ -169,6 +173,23 @@ void Application::setLoaded(const bool newLoaded) noexcept
     }
 }
 
+bool Application::getShutdown() const noexcept
+{
+    return shutdown.load();
+}
+
+bool Application::getRefreshing() const noexcept
+{
+    return refreshing.load();
+}
+
+void Application::setRefreshing(const bool newRefreshing) noexcept
+{
+    if (bool expected = !newRefreshing; refreshing.compare_exchange_strong(expected, newRefreshing)) {
+        emit notifyRefreshingChanged();
+    }
+}
+
 QString Application::getLoadingTitle() const noexcept
 {
     return loading;
@@ -176,6 +197,9 @@ QString Application::getLoadingTitle() const noexcept
 
 void Application::setLoadingTitle(const QString& title) noexcept
 {
+    if (refreshing) {
+        return;
+    }
     loading = title;
     emit notifyLoadingTitleChanged();
 }
@@ -194,23 +218,35 @@ void Application::setupData() noexcept
 {
     if (dataLoad->result()) {
         // Setup data models
-        technologiesModel.load(provider.getData().allTechnologies);
-        typesModel.load(provider.getData().allTypes);
-        categoriesModel.load(provider.getData().allCategories);
-        intrinsicsModel.load(provider.getData().instructions);
-
-        intrinsicProxyModel.load(technologiesModel.allTechnologies, typesModel.allTypes, categoriesModel.allCategories);
+        const auto dataset = provider.getDataset();
+        QList<QString> technologies = dataset->getTechnologies();
+        QList<QString> types = dataset->getTypes();
+        QList<QString> categories = dataset->getCategories();
+        technologiesModel.load(technologies);
+        typesModel.load(types);
+        categoriesModel.load(categories);
+        intrinsicsModel.load(dataset);
+
+        intrinsicProxyModel.setSearchIndex(provider.getSearchIndex());
+        intrinsicProxyModel.setPerformanceIndex(provider.getPerformanceIndex());
+        intrinsicProxyModel.setFacetIndex(provider.getFacetIndex());
+        intrinsicProxyModel.load(technologiesModel.checkedMask, typesModel.checkedMask, categoriesModel.checkedMask);
 
         connect(&technologiesModel, &TechnologyModel::technologyChanged, &intrinsicProxyModel,
             &IntrinsicProxyModel::filterUpdated);
         connect(&typesModel, &TypeModel::typesChanged, &intrinsicProxyModel, &IntrinsicProxyModel::filterUpdated);
         connect(&categoriesModel, &CategoryModel::categoriesyChanged, &intrinsicProxyModel,
             &IntrinsicProxyModel::filterUpdated);
+        connect(&intrinsicProxyModel, &IntrinsicProxyModel::facetCountsChanged, this,
+            [this](const QList<uint32_t>& technologies, const QList<uint32_t>& types,
+                const QList<uint32_t>& categories) {
+                technologiesModel.setCounts(technologies);
+                typesModel.setCounts(types);
+                categoriesModel.setCounts(categories);
+            });
+        intrinsicProxyModel.updateFacetCounts();
 
-        dataVersion = std::move(provider.getData().version);
-
-        // Clear data provider
-        provider.clear();
+        dataVersion = dataset->getVersion().toString();
 
         // Remove future
         disconnect(watcher.get(), &QFutureWatcher<bool>::finished, this, &Application::setupData);
@@ -221,6 +257,11 @@ void Application::setupData() noexcept
         emit notifyDataVersionChanged();
         setProgress(1.0F);
         setLoaded(true);
+
+        // Out of date data is displayed while upstream is checked for changes
+        if (provider.isStale()) {
+            startUpdate();
+        }
     } else {
         setProgress(0.0F);
         setLoaded(true);
@@ -228,3 +269,41 @@ void Application::setupData() noexcept
         addOKDialog("Failed to get intrinsic data", [] { QGuiApplication::exit(); });     
     }
 }
+
+void Application::updateData() noexcept
+{
+    const bool updated = dataLoad->result();
+
+    // Remove future
+    disconnect(watcher.get(), &QFutureWatcher<bool>::finished, this, &Application::updateData);
+    dataLoad = nullptr;
+    watcher = nullptr;
+
+    if (!updated) {
+        setRefreshing(false);
+        return;
+    }
+
+    // Swap the new data into the existing models so that any filters, search and expanded rows are kept. This waits on
+    // the current search being repeated against the new data so that both are applied together.
+    intrinsicProxyModel.setSearchIndex(provider.getSearchIndex(),
+        [this, dataset = provider.getDataset(), performanceIndex = provider.getPerformanceIndex(),
+            facetIndex = provider.getFacetIndex()] {
+            // The filter lists must be updated before the intrinsics as the intrinsics index into them
+            QList<QString> technologies = dataset->getTechnologies();
+            QList<QString> types = dataset->getTypes();
+            QList<QString> categories = dataset->getCategories();
+            technologiesModel.update(technologies);
+            typesModel.update(types);
+            categoriesModel.update(categories);
+            intrinsicProxyModel.checkedUpdated();
+            intrinsicProxyModel.setPerformanceIndex(performanceIndex);
+            intrinsicProxyModel.setFacetIndex(facetIndex);
+            intrinsicsModel.update(dataset);
+            intrinsicProxyModel.updateFacetCounts();
+
+            dataVersion = dataset->getVersion().toString();
+            emit notifyDataVersionChanged();
+            setRefreshing(false);
+        });
+}
@@ -35,6 +35,8 @@ QVariant CategoryModel::data(const QModelIndex& index, const int role) const noe
                 return allCategories.at(index.row()).name;
             case CategoryRoleChecked:
                 return allCategories.at(index.row()).checked;
+            case CategoryRoleCount:
+                return allCategories.at(index.row()).count;
             default:
                 break;
         }
@@ -45,7 +47,10 @@ QVariant CategoryModel::data(const QModelIndex& index, const int role) const noe
 QHash<int, QByteArray> CategoryModel::roleNames() const noexcept
 {
     static const QHash<int, QByteArray> roles{
-        {CategoryRoleName, "categoryName"}, {CategoryRoleChecked, "categoryChecked"}};
+        {CategoryRoleName, "categoryName"},
+        {CategoryRoleChecked, "categoryChecked"},
+        {CategoryRoleCount, "categoryCount"},
+    };
     return roles;
 }
 
@@ -64,6 +69,9 @@ bool CategoryModel::setData(const QModelIndex& index, const QVariant& value, con
         if (role == CategoryRoleChecked) {
             // Update the value
             allCategories[index.row()].checked = value.toBool();
+            if (static_cast<size_t>(index.row()) < checkedMask.size()) {
+                checkedMask.set(static_cast<size_t>(index.row()), value.toBool());
+            }
             emit dataChanged(index, index, {role});
             emit categoriesyChanged();
             return true;
@@ -87,5 +95,125 @@ void CategoryModel::load(QList<QString>& categories) noexcept
     for (auto& i : categories) {
         allCategories.emplaceBack(std::move(i));
     }
+    updateMask();
     emit endInsertRows();
 }
+
+void CategoryModel::update(QList<QString>& categories) noexcept
+{
+    // Remove any items that no longer exist
+    for (auto i = allCategories.count() - 1; i >= 0; --i) {
+        if (!categories.contains(allCategories[i].name)) {
+            beginRemoveRows(QModelIndex(), static_cast<int>(i), static_cast<int>(i));
+            allCategories.removeAt(i);
+            endRemoveRows();
+        }
+    }
+    // Insert any new items in place
+    for (qsizetype i = 0; i < categories.count(); ++i) {
+        if (i < allCategories.count() && allCategories[i].name == categories[i]) {
+            continue;
+        }
+        if (allCategories.indexOf(categories[i], i) != -1) {
+            // The existing items have been reordered so fall back to reloading while keeping the checked items
+            beginResetModel();
+            QList<StringChecked> old = std::move(allCategories);
+            for (auto& j : categories) {
+                const auto found = std::find(old.cbegin(), old.cend(), j);
+                allCategories.emplaceBack(std::move(j)).checked = found != old.cend() && found->checked;
+            }
+            updateMask();
+            endResetModel();
+            return;
+        }
+        beginInsertRows(QModelIndex(), static_cast<int>(i), static_cast<int>(i));
+        allCategories.insert(i, StringChecked(QString(categories[i])));
+        endInsertRows();
+    }
+    updateMask();
+}
+
+void CategoryModel::setCounts(const QList<uint32_t>& counts) noexcept
+{
+    // Only the changed range is signalled so that unchanged delegates are not updated
+    qsizetype first = -1;
+    qsizetype last = -1;
+    for (qsizetype i = 0; i < std::min(allCategories.count(), counts.count()); ++i) {
+        if (allCategories[i].count != counts[i]) {
+            allCategories[i].count = counts[i];
+            first = first < 0 ? i : first;
+            last = i;
+        }
+    }
+    if (first >= 0) {
+        emit dataChanged(index(static_cast<int>(first)), index(static_cast<int>(last)), {CategoryRoleCount});
+    }
+}
+
+void CategoryModel::setAllChecked(const bool checked) noexcept
+{
+    FilterMask mask;
+    if (checked) {
+        for (qsizetype i = 0; i < std::min(allCategories.count(), static_cast<qsizetype>(mask.size())); ++i) {
+            mask.set(static_cast<size_t>(i));
+        }
+    }
+    setCheckedMask(mask);
+}
+
+void CategoryModel::invertChecked() noexcept
+{
+    FilterMask mask = checkedMask;
+    for (qsizetype i = 0; i < std::min(allCategories.count(), static_cast<qsizetype>(mask.size())); ++i) {
+        mask.flip(static_cast<size_t>(i));
+    }
+    setCheckedMask(mask);
+}
+
+void CategoryModel::setCheckedNames(const QList<QString>& names) noexcept
+{
+    FilterMask mask;
+    for (qsizetype i = 0; i < std::min(allCategories.count(), static_cast<qsizetype>(mask.size())); ++i) {
+        mask.set(static_cast<size_t>(i), names.contains(allCategories[i].name));
+    }
+    setCheckedMask(mask);
+}
+
+QList<QString> CategoryModel::getCheckedNames() const noexcept
+{
+    QList<QString> ret;
+    for (const auto& i : allCategories) {
+        if (i.checked) {
+            ret.append(i.name);
+        }
+    }
+    return ret;
+}
+
+void CategoryModel::setCheckedMask(const FilterMask& mask) noexcept
+{
+    // All items are updated before a single notification so that the filter is only updated once
+    qsizetype first = -1;
+    qsizetype last = -1;
+    for (qsizetype i = 0; i < std::min(allCategories.count(), static_cast<qsizetype>(mask.size())); ++i) {
+        if (const bool checked = mask.test(static_cast<size_t>(i)); allCategories[i].checked != checked) {
+            allCategories[i].checked = checked;
+            first = first < 0 ? i : first;
+            last = i;
+        }
+    }
+    if (first < 0) {
+        return;
+    }
+    updateMask();
+    emit dataChanged(index(static_cast<int>(first)), index(static_cast<int>(last)), {CategoryRoleChecked});
+    emit categoriesyChanged();
+}
+
+void CategoryModel::updateMask() noexcept
+{
+    checkedMask.reset();
+    for (qsizetype i = 0; i < std::min(allCategories.count(), static_cast<qsizetype>(checkedMask.size())); ++i) {
+        checkedMask.set(static_cast<size_t>(i), allCategories[i].checked);
+    }
+}
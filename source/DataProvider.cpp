@@ -16,15 +16,28 @@
 
 #include "DataProvider.h"
 
-#include "Application.h"
 #include "Downloader.h"
+#include "SignatureFormatter.h"
 
 #include <QDateTime>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QLocale>
+#include <QSaveFile>
+#include <QSet>
+#include <QScopeGuard>
+#include <QTimeZone>
+#include <QXmlStreamReader>
+#include <QtConcurrent>
 
-constexpr uint32_t fileVersion = 0x011100;
-constexpr uint32_t fileID = 0xA654BE39;
+const QString embeddedFile = ":/dataCache";
+const QString intrinName = "Intel Intrinsic Guide";
+const QUrl intrinUrl =
+    QUrl("https://www.intel.com/content/dam/develop/public/us/en/include/intrinsics-guide/data-latest.xml");
+const QString uopsName = "uops.info";
+const QUrl uopsUrl = QUrl("https://www.uops.info/instructions.xml");
 
-DataProvider::DataProvider(Application* parent) noexcept
+DataProvider::DataProvider(DataProviderHost* parent) noexcept
     : parentApp(parent)
 {}
 
@@ -40,31 +53,108 @@ void DataProvider::addProgress(const float value) noexcept
     parentApp->setProgress(progress);
 }
 
-InternalData& DataProvider::getData() noexcept
+std::shared_ptr<Dataset> DataProvider::getDataset() const noexcept
 {
-    return data;
+    return dataset;
+}
+
+std::shared_ptr<SearchIndex> DataProvider::getSearchIndex() const noexcept
+{
+    return searchIndex;
+}
+
+std::shared_ptr<PerformanceIndex> DataProvider::getPerformanceIndex() const noexcept
+{
+    return performanceIndex;
+}
+
+std::shared_ptr<FacetIndex> DataProvider::getFacetIndex() const noexcept
+{
+    return facetIndex;
 }
 
 bool DataProvider::setup() noexcept
 {
+    // Replace the existing cache with any newer data created by a previous update
+    if (QFile::exists(updateFile)) {
+        QFile::remove(cacheFile);
+        if (!QFile::rename(updateFile, cacheFile)) {
+            qWarning() << "Failed to replace data cache: " + cacheFile;
+        }
+    }
+
+    // Load any existing cache from disk, falling back to the data embedded in the executable. Out of date data is still
+    // used straight away and is only checked against upstream once update is called.
     bool success = true;
-    // Load any existing cache from disk
-    if (!load()) {
-        // If no cache found then create new one
+    stale = false;
+    if (!load(cacheFile, stale) && !loadEmbedded(stale)) {
+        // If no valid cache found then create new one
         success = create();
         if (success) {
-            // Backup created cache to disk
-            (void)store();
+#ifndef _DEBUG
+            // Delete old cache
+            if (QFile file(intrinFile); file.exists()) {
+                file.remove();
+            }
+            if (QFile file(uopsFile); file.exists()) {
+                file.remove();
+            }
+#endif
+            success = store(cacheFile);
         }
     }
 
     if (success) {
+        createIndexes();
         // Remove loading progress from parent
         parentApp->setProgress(1.0F);
     }
     return success;
 }
 
+bool DataProvider::update() noexcept
+{
+    stale = false;
+    if (dataset == nullptr || revalidate()) {
+        return false;
+    }
+    // A failed revalidation may just be due to shutdown being called, in which case nothing should be recreated
+    if (parentApp->getShutdown()) {
+        return false;
+    }
+    // The existing cache is still in use so the new data is written alongside it
+    if (!create()) {
+        return false;
+    }
+#ifndef _DEBUG
+    // Delete old cache
+    if (QFile file(intrinFile); file.exists()) {
+        file.remove();
+    }
+    if (QFile file(uopsFile); file.exists()) {
+        file.remove();
+    }
+#endif
+    if (!store(updateFile)) {
+        return false;
+    }
+    createIndexes();
+    return true;
+}
+
+bool DataProvider::isStale() const noexcept
+{
+    return stale;
+}
+
+bool DataProvider::build(const QString& intrinPath, const QString& uopsPath, const QString& outputPath) noexcept
+{
+    intrinFile = intrinPath;
+    uopsFile = uopsPath;
+    cacheFile = outputPath;
+    return create() && store(cacheFile);
+}
+
 void DataProvider::clear()
 {
     data.instructions.clear();
@@ -72,59 +162,155 @@ void DataProvider::clear()
     data.allTypes.clear();
     data.allCategories.clear();
     data.version.clear();
+    data.date = QDate();
+    data.validators.clear();
+    loadedFile.clear();
+    dataset = nullptr;
+    searchIndex = nullptr;
+    performanceIndex = nullptr;
+    facetIndex = nullptr;
 }
 
-bool DataProvider::load() noexcept
+bool DataProvider::load(const QString& fileName, bool& outdated) noexcept
 {
-    if (QFile fileCache("./dataCache"); fileCache.exists() && fileCache.open(QIODevice::ReadOnly)) {
+    if (QFile::exists(fileName)) {
         // Reset UI values to default
         progressModifier = 1.0F;
         progress = 0.0F;
         parentApp->setLoadingTitle("Loading...");
         parentApp->setProgress(0.0F);
 
-        // Load data from cache
+        // Map the cache directly, the data is then used in place without any further loading
         parentApp->setLoadingTitle("Loading data from cache...");
-        QDataStream in(&fileCache);
-        uint32_t check = 0;
-        in >> check;
-        if (check != fileID) {
-            qWarning() << "Cached data file had invalid identifier";
+        dataset = Dataset::open(fileName);
+        if (dataset == nullptr) {
             return false;
         }
-        in >> check;
-        if (check != fileVersion) {
-            qInfo() << "Cached data version is to old, recreating from upstream sources";
-            return false;
+        loadedFile = fileName;
+        outdated = QDateTime(dataset->getDate(), QTime::currentTime()).daysTo(QDateTime::currentDateTime()) > 180;
+        if (outdated) {
+            qInfo() << "Cached data is to old, checking upstream sources for changes";
         }
-        in >> data.date;
-        if (QDateTime(data.date, QTime::currentTime()).daysTo(QDateTime::currentDateTime()) > 180) {
-            qInfo() << "Cached data is to old, recreating from upstream sources";
-            return false;
-        }
-        in.setVersion(QDataStream::Qt_6_8);
-        in >> data;
         addProgress(1.0F);
         return true;
     }
     return false;
 }
 
-bool DataProvider::store() noexcept
+bool DataProvider::loadEmbedded(bool& outdated) noexcept
 {
-    // Stream data model to disk
-    if (QFile fileCache("./dataCache"); fileCache.open(QIODevice::WriteOnly)) {
-        parentApp->setLoadingTitle("Writing data store to disk...");
-        // Store data from cache
-        QDataStream out(&fileCache);
-        out << fileID;
-        out << fileVersion;
-        out << data.date;
-        out.setVersion(QDataStream::Qt_6_8);
-        out << data;
-        addProgress(1.0F);
+    if (!QFile::exists(embeddedFile)) {
+        return false;
+    }
+    // Copy the embedded data to the cache so that it can be memory mapped and updated like any other cache
+    if (QFile::exists(cacheFile)) {
+        QFile::remove(cacheFile);
+    }
+    if (QFile::copy(embeddedFile, cacheFile)) {
+        // Files copied from resources are read only
+        QFile::setPermissions(cacheFile, QFileDevice::ReadOwner | QFileDevice::WriteOwner);
+        if (load(cacheFile, outdated)) {
+            return true;
+        }
+    }
+    // Otherwise use the embedded data directly
+    return load(embeddedFile, outdated);
+}
+
+bool DataProvider::store(const QString& fileName) noexcept
+{
+    parentApp->setLoadingTitle("Writing data store to disk...");
+    QByteArray buffer = Dataset::build(data);
+    // Release any existing mapping of the cache so that it can be replaced
+    dataset = nullptr;
+    loadedFile.clear();
+    const QByteArray compressed = Dataset::compress(buffer);
+    if (QSaveFile fileCache(fileName); fileCache.open(QIODevice::WriteOnly) &&
+        fileCache.write(compressed) == compressed.size() && fileCache.commit()) {
+        loadedFile = fileName;
+    } else {
+        qCritical() << "Failed to write data cache: " + fileName;
+    }
+    // The uncompressed data is used directly as it is already in memory
+    dataset = Dataset::open(std::move(buffer));
+
+    // The intermediate data is no longer needed
+    data.instructions.clear();
+    data.allTechnologies.clear();
+    data.allTypes.clear();
+    data.allCategories.clear();
+    addProgress(1.0F);
+    return dataset != nullptr;
+}
+
+void DataProvider::createIndexes() noexcept
+{
+    parentApp->setLoadingTitle("Creating search index...");
+#ifdef _DEBUG
+    QElapsedTimer indexTimer;
+    indexTimer.start();
+#endif
+    searchIndex = std::make_shared<SearchIndex>(dataset);
+    performanceIndex = std::make_shared<PerformanceIndex>(*dataset);
+    facetIndex = std::make_shared<FacetIndex>(*dataset);
+#ifdef _DEBUG
+    qDebug() << "Created search, performance and facet indexes in" << indexTimer.elapsed() << "ms";
+#endif
+}
+
+bool DataProvider::revalidate() noexcept
+{
+    // Reset UI values to default
+    progressModifier = 1.0F;
+    progress = 0.0F;
+    parentApp->setLoadingTitle("Checking for updated data...");
+    parentApp->setProgress(0.0F);
+
+    // Ask for each source only if it differs from the data used to build the cache. Any changed source is written
+    // straight to its file cache so that it can be used by create without downloading it again.
+    Downloader dl([this](const float value) { setProgress(value); }, [this] { return parentApp->getShutdown(); });
+    data.validators = dataset->getValidators();
+    const SourceValidator intrinValidator = getValidator(intrinUrl);
+    const SourceValidator uopsValidator = getValidator(uopsUrl);
+    const uint32_t intrinDownload = dl.add(intrinUrl, intrinFile, intrinValidator.eTag, intrinValidator.lastModified);
+    const uint32_t uopsDownload = dl.add(uopsUrl, uopsFile, uopsValidator.eTag, uopsValidator.lastModified);
+    const bool intrinSuccess = dl.wait(intrinDownload);
+    const bool uopsSuccess = dl.wait(uopsDownload);
+
+    // Check if shutdown has been called
+    if (parentApp->getShutdown()) {
+        return false;
+    }
+
+    if (!intrinSuccess || !uopsSuccess) {
+        // Upstream could not be reached so keep using the existing data until the next check
+        qWarning() << "Failed to check upstream sources for changes, using existing cached data";
         return true;
     }
+    if (dl.isNotModified(intrinDownload) && dl.isNotModified(uopsDownload)) {
+        // Nothing has changed so just extend the lifetime of the existing cache
+        qInfo() << "Upstream sources have not changed, extending lifetime of cached data";
+        // Only the file the data was read from is extended. Embedded data cannot be written and any pending update
+        // replaces the cache on the next start so changing either would have no lasting effect.
+        if (loadedFile.isEmpty() || loadedFile == embeddedFile ||
+            (loadedFile == cacheFile && QFile::exists(updateFile))) {
+            qInfo() << "Loaded data is not the data cache, its lifetime is only extended for this session";
+        } else if (!Dataset::updateDate(loadedFile, QDate::currentDate())) {
+            qWarning() << "Failed to update data cache: " + loadedFile;
+        }
+        return true;
+    }
+
+    // Keep the validators of any changed sources for when the cache is recreated
+    if (!dl.isNotModified(intrinDownload)) {
+        data.validators[intrinUrl.toString()] =
+            SourceValidator(dl.getETag(intrinDownload), dl.getLastModified(intrinDownload));
+    }
+    if (!dl.isNotModified(uopsDownload)) {
+        data.validators[uopsUrl.toString()] =
+            SourceValidator(dl.getETag(uopsDownload), dl.getLastModified(uopsDownload));
+    }
+    qInfo() << "Upstream sources have changed, recreating from upstream sources";
     return false;
 }
 
@@ -133,86 +319,92 @@ bool DataProvider::create() noexcept
     // Reset UI values to default
     progressModifier = 1.0F / 8.0F;
     progress = 0.0F;
+    downloadCount = 0;
     parentApp->setLoadingTitle("Creating...");
     parentApp->setProgress(0.0F);
 
-    QDomDocument dataXMLIntel, dataXMLOps;
-    QString intrinFile = "./intrin.xml";
-    QString uopsFile = "./uops.xml";
-    if (!downloadCache(intrinFile, "Intel Intrinsic Guide", dataXMLIntel,
-            QUrl("https://www.intel.com/content/dam/develop/public/us/en/include/intrinsics-guide/data-latest.xml"))) {
+    // Remove any previously loaded data, the validators are kept as they still describe any existing file caches
+    data.instructions.clear();
+    data.allTechnologies.clear();
+    data.allTypes.clear();
+    data.allCategories.clear();
+
+    // Start all required downloads up front so that they run concurrently
+    Downloader dl([this](const float value) { setProgress(value * 2.0F * downloadCount); },
+        [this] { return parentApp->getShutdown(); });
+    const int32_t intrinDownload = startCache(dl, intrinFile, intrinName, intrinUrl);
+    const int32_t uopsDownload = startCache(dl, uopsFile, uopsName, uopsUrl);
+    if (!finishCache(dl, intrinDownload, intrinFile, intrinName, intrinUrl)) {
         return false;
     }
-    if (!downloadCache(uopsFile, "uops.info", dataXMLOps, QUrl("https://www.uops.info/instructions.xml"))) {
+
+    // Read the intrinsic data straight from the cached file while the uops data is still downloading
+    QList<Instruction> instructions;
+    QFile intrinCache(intrinFile);
+    if (!intrinCache.open(QIODevice::ReadOnly)) {
+        qCritical() << "Failed to open XML cache: " + intrinFile;
+        parentApp->addOKDialog("Failed to read Intel Intrinsic Guide data", [] {});
         return false;
     }
+    QFuture<bool> intrinParse =
+        QtConcurrent::run([this, &intrinCache, &instructions] { return parseIntrinsics(intrinCache, instructions); });
+    // The parse must be complete before any of the above locals go out of scope
+    const auto waitIntrinsics = qScopeGuard([&intrinParse] { intrinParse.waitForFinished(); });
 
-    parentApp->setLoadingTitle("Creating data store...");
-    // Scan through intrinsic data for each function
-    QDomElement root = dataXMLIntel.documentElement();
-    QDomElement root2 = dataXMLOps.documentElement();
-    data.version = root.attribute("version", "3.6.7");
-    QDate currentDate = QDate::currentDate();
-    data.date = QDate::fromString(root.attribute("date", currentDate.toString()), "MM/dd/yyyy");
-#ifdef _DEBUG
-    if (!data.date.isValid()) {
-        qDebug() << "Invalid source date detected for intrinsic guide data:" << root.attribute("date", currentDate.toString());
-        data.date = currentDate;
+    if (!finishCache(dl, uopsDownload, uopsFile, uopsName, uopsUrl)) {
+        return false;
     }
-#endif
-    if (QDateTime(data.date, QTime::currentTime()).daysTo(QDateTime::currentDateTime()) > 180) {
-        qInfo() << "Upstream intrinsic guide data has not been updated in over 180 days. Setting cache date to current date";
-        data.date = currentDate;
+    addProgress(2.0F * downloadCount);
+
+    // Read the uops data into an index keyed by iform so that each intrinsic is a direct lookup
+    UopsIndex uopsIndex;
+    // The index and join times are always reported so that the cost of creating the data can be measured in release
+    // builds (e.g. by running DatasetBuilder on the upstream XML)
+    QElapsedTimer joinTimer;
+    joinTimer.start();
+    if (QFile fileCache(uopsFile); fileCache.open(QIODevice::ReadOnly)) {
+        parentApp->setLoadingTitle("Reading uops.info...");
+        if (!parseUops(fileCache, uopsIndex)) {
+            // Check if shutdown has been called
+            if (parentApp->getShutdown()) {
+                return false;
+            }
+            // Delete broken file cache
+            fileCache.remove();
+            parentApp->addOKDialog("Failed to pass uops.info data", [] {});
+            return false;
+        }
+    } else {
+        qCritical() << "Failed to open XML cache: " + uopsFile;
+        parentApp->addOKDialog("Failed to read uops.info data", [] {});
+        return false;
     }
+    addProgress(1.0F);
+    qInfo() << "Indexed" << uopsIndex.size() << "uops instruction forms in" << joinTimer.elapsed() << "ms";
 
-    const QMap<QString, QString> typesPretty = {
-        {"BF16",                     "BFloat16"},
-        {"FP16",               "Float16 (half)"},
-        {"FP32",              "Float32 (float)"},
-        {"FP64",             "Float64 (double)"},
-        {"MASK",                         "Mask"},
-        {"SI16",    "Integer Signed 16 (int16)"},
-        {"SI32",    "Integer Signed 32 (int32)"},
-        {"SI64",    "Integer Signed 64 (int64)"},
-        { "SI8",      "Integer Signed 8 (int8)"},
-        {"UI16", "Integer Unsigned 16 (uint16)"},
-        {"UI32", "Integer Unsigned 32 (uint32)"},
-        {"UI64", "Integer Unsigned 64 (uint64)"},
-        { "UI8",   "Integer Unsigned 8 (uint8)"}
-    };
+    // Check if shutdown has been called
+    if (parentApp->getShutdown()) {
+        return false;
+    }
 
-    const QMap<QString, QString> archsPretty = {
-        {  "CON",              "Conroe"},
-        {  "WOL",            "Wolfdale"},
-        {  "NHM",             "Nehalem"},
-        {  "WSM",            "Westmere"},
-        {  "SNB",        "Sandy Bridge"},
-        {  "IVB",          "Ivy Bridge"},
-        {  "HSW",             "Haswell"},
-        {  "BDW",           "Broadwell"},
-        {  "SKL",             "Skylake"},
-        {  "SKX",           "Skylake-X"},
-        {  "KBL",           "Kaby Lake"},
-        {  "CFL",         "Coffee Lake"},
-        {  "CNL",         "Cannon Lake"},
-        {  "CLX",        "Cascade Lake"},
-        {  "ICL",            "Ice Lake"},
-        {  "TGL",          "Tiger Lake"},
-        {  "RKL",         "Rocket Lake"},
-        { "ZEN+",                "Zen+"},
-        { "ZEN2",                "Zen2"},
-        { "ZEN3",                "Zen3"},
-        { "ZEN4",                "Zen4"},
-        { "ZEN5",                "Zen5"},
-        {"ADL-P", "Alder Lake (P-Core)"},
-        {"ADL-E", "Alder Lake (E-Core)"},
-        {  "BNL",             "Bonnell"},
-        {  "AMT",             "Airmont"},
-        {  "GLM",            "Goldmont"},
-        {  "GLP",           "Goldmont+"},
-        {  "TRM",             "Tremont"}
-    };
+    // Wait for the intrinsic data to finish parsing
+    parentApp->setLoadingTitle("Reading Intel Intrinsic Guide...");
+    if (!intrinParse.result()) {
+        // Check if shutdown has been called
+        if (parentApp->getShutdown()) {
+            return false;
+        }
+        // Delete broken file cache
+        intrinCache.remove();
+        parentApp->addOKDialog("Failed to pass Intel Intrinsic Guide data", [] {});
+        return false;
+    }
+    intrinCache.close();
+    addProgress(1.0F);
 
+    parentApp->setLoadingTitle("Creating data store...");
+    // Only the join itself is timed, not the wait for the intrinsic data to finish parsing
+    joinTimer.restart();
     const QMap<QString, QString> xedConversions = {
         {"MASKMOVDQU_XMMdq_XMMdq", "MASKMOVDQU_XMMxub_XMMxub"},
         {     "MOVLPS_MEMq_XMMps",         "MOVLPS_MEMq_XMMq"},
@@ -220,395 +412,97 @@ bool DataProvider::create() noexcept
         {   "MOVQ_MEMq_XMMq_0F7E",      "MOVQ_MEMq_XMMq_0FD6"}
     };
 
-    QList<Instruction> instructions;
-
-    // Loop through each element and get information
-    for (auto i = root.firstChild(); !i.isNull(); i = i.nextSibling()) {
-        // Check if the child tag name is an 'intrinsic'
-        if (auto node = i.toElement(); !node.isNull() && node.tagName() == "intrinsic") {
-            // Get the intrinsic attributes
-            // tech: is Technologies selection where cpuids is subsection to tech (when not equal)
-            // types: is integer/floating point etc.
-            // name: is intrinsic name
-            // description: is text description of intrinsic operation
-            // operation: is pseudo code of intrinsic operation
-            // header: is the header file the intrinsic is declared in.
-            QString tech = node.attribute("tech", "Unknown");
-            QString name = node.attribute("name");
-            QList<QString> types, cpuids, categories, xeds;
-            QString description, operation, header, instruction;
-            QString returnParam, returnName;
-            QList<QPair<QString, QString>> parameters;
-            if (name.isEmpty()) {
-#ifdef _DEBUG
-                qDebug() << "Intrinsic element in xml file did not have name attribute: " + node.toText().data();
-#endif
-                continue;
-            }
-            // Get each child nodes data
-            for (auto child = node.firstChild(); !child.isNull(); child = child.nextSibling()) {
-                if (auto childE = child.toElement(); !childE.isNull()) {
-                    // Read Name and value
-                    if (childE.tagName() == "type") {
-                        // Can have multiple type nodes (e.g. Integer and Flag)
-                        if (auto t = childE.firstChild().toText(); !t.isNull()) {
-                            types.emplaceBack(t.data());
-                        }
-                    } else if (childE.tagName() == "CPUID") {
-                        // Can have multiple cpuid nodes (e.g. different AVX512 sets)
-                        if (auto t = childE.firstChild().toText(); !t.isNull()) {
-                            cpuids.emplaceBack(t.data());
-                        }
-                    } else if (childE.tagName() == "category") {
-                        if (auto t = childE.firstChild().toText(); !t.isNull()) {
-                            categories.emplaceBack(t.data());
-                        }
-                    } else if (childE.tagName() == "return") {
-                        // Has attributes for type, varname, etype
-                        returnParam = childE.attribute("type", "");
-                        returnName = childE.attribute("varname", "");
-                        if (childE.hasAttribute("etype")) {
-                            QString etype = childE.attribute("etype", "");
-                            QString pretty = typesPretty.contains(etype) ? typesPretty[etype] : std::move(etype);
-                            if (pretty == "M128" || pretty == "M256" || pretty == "M512") {
-                                if (returnParam.contains("void")) {
-                                    pretty.clear();
-                                } else if (returnParam.contains("__m128i") || returnParam.contains("__m256i") ||
-                                    returnParam.contains("__m512i")) {
-                                    pretty = "Integer (variable)";
-                                } else if (returnParam.contains("__m128") || returnParam.contains("__m256") ||
-                                    returnParam.contains("__m512")) {
-                                    pretty = typesPretty["FP32"];
-                                } else if (returnParam.contains("__m128d") || returnParam.contains("__m256d") ||
-                                    returnParam.contains("__m512d")) {
-                                    pretty = typesPretty["FP64"];
-                                } else if (returnParam.contains("__m128h") || returnParam.contains("__m256h") ||
-                                    returnParam.contains("__m512h")) {
-                                    pretty = typesPretty["FP16"];
-                                } else {
-#ifdef _DEBUG
-                                    qDebug() << "Unknown type: " << returnParam;
-#endif
-                                    pretty = "";
-                                }
-                            }
-                            if (!pretty.isEmpty() && !types.contains(pretty)) {
-                                types.emplaceBack(std::move(pretty));
-                            }
-                        }
-                    } else if (childE.tagName() == "parameter") {
-                        // Can have multiple parameters
-                        // Has same attributes as 'return'
-                        QString typeParam = childE.attribute("type", "");
-                        QString nameParam = childE.attribute("varname", "");
-                        parameters.emplaceBack(qMakePair(typeParam, nameParam));
-                        if (childE.hasAttribute("etype")) {
-                            if (QString etype = childE.attribute("etype", ""); etype != "IMM") {
-                                QString pretty = typesPretty.contains(etype) ? typesPretty[etype] : std::move(etype);
-                                if (pretty == "M128" || pretty == "M256" || pretty == "M512") {
-                                    if (typeParam.contains("void")) {
-                                        pretty.clear();
-                                    } else if (typeParam.contains("__m128i") || typeParam.contains("__m256i") ||
-                                        typeParam.contains("__m512i")) {
-                                        pretty = "Integer (variable)";
-                                    } else if (typeParam.contains("__m128") || typeParam.contains("__m256") ||
-                                        typeParam.contains("__m512")) {
-                                        pretty = typesPretty["FP32"];
-                                    } else if (typeParam.contains("__m128d") || typeParam.contains("__m256d") ||
-                                        typeParam.contains("__m512d")) {
-                                        pretty = typesPretty["FP64"];
-                                    } else if (typeParam.contains("__m128h") || typeParam.contains("__m256h") ||
-                                        typeParam.contains("__m512h")) {
-                                        pretty = typesPretty["FP16"];
-                                    } else {
-#ifdef _DEBUG
-                                        qDebug() << "Unknown type: " << typeParam;
-#endif
-                                        pretty = "";
-                                    }
-                                }
-                                if (!pretty.isEmpty() && !types.contains(pretty)) {
-                                    types.emplaceBack(std::move(pretty));
-                                }
-                            }
-                        }
-                    } else if (childE.tagName() == "description") {
-                        if (auto t = childE.firstChild().toText(); !t.isNull()) {
-                            description = t.data();
-                        }
-                    } else if (childE.tagName() == "operation") {
-                        if (auto t = childE.firstChild().toText(); !t.isNull()) {
-                            operation = t.data().trimmed();
-                        }
-                    } else if (childE.tagName() == "instruction") {
-                        // Has attributes xed, form, name
-                        QString xed = childE.attribute("xed", "");
-                        if (!xed.isEmpty() && !xeds.contains(xed)) {
-                            xeds.emplaceBack(std::move(xed));
-                        }
-                        if (!instruction.isEmpty()) {
-                            instruction += ',';
-                        }
-                        instruction += childE.attribute("name", "");
-                    } else if (childE.tagName() == "header") {
-                        if (auto t = childE.firstChild().toText(); !t.isNull()) {
-                            header = t.data();
-                        }
-                    }
-                }
-            }
-            if (types.isEmpty()) {
-                types.append("Other");
-            }
-            // Skip SVML as its intel compiler only
-            if (tech == "SVML" || tech == "KNC") {
-                continue;
-            }
-
-            // Get corresponding value from uops
-            QList<Measurements> measurements;
-            if (!xeds.isEmpty()) {
-                // uops info stores instructions by extension name (cpuid)
-                bool found = false;
-                bool secondLoop = false;
-                QString cpuid;
-                for (auto& j : cpuids) {
-                    cpuid = j; // Generally the last one is fine
-                }
-                // Perform required conversions between intrinsic and uops arch names
-                if (cpuid == "ADX") {
-                    cpuid = "ADOX_ADCX";
-                } else if (cpuid == "AVX2") {
-                    // Allow searching through AVX subdomains
-                    cpuid = "AVX";
-                } else if (cpuid.startsWith("AVX512")) {
-                    // Allow searching through AVX512 subdomains
-                    cpuid = "AVX512";
-                }
-                while (true) {
-                    for (auto k = root2.firstChild(); !k.isNull() && !found; k = k.nextSibling()) {
-                        if (auto elem = k.toElement(); elem.tagName() == "extension") {
-                            // Check if the child tag name matches our requested cpuid
-                            if (secondLoop || elem.attribute("name").startsWith(cpuid)) {
-                                // Search for element containing required xed
-                                for (auto child = elem.firstChild(); !child.isNull(); child = child.nextSibling()) {
-                                    for (const auto& xed : xeds) {
-                                        if (auto childE = child.toElement(); !found && !childE.isNull() &&
-                                            childE.tagName() == "instruction" && childE.attribute("iform") == xed) {
-                                            found = true;
-                                            for (auto child2 = child.firstChild(); !child2.isNull();
-                                                 child2 = child2.nextSibling()) {
-                                                if (auto child2E = child2.toElement();
-                                                    !child2E.isNull() && child2E.tagName() == "architecture") {
-                                                    QString arch = child2E.attribute("name");
-                                                    QString archPretty = archsPretty.contains(arch) ?
-                                                        archsPretty[arch] :
-                                                        std::move(arch);
-                                                    for (auto child3 = child2.firstChild(); !child3.isNull();
-                                                         child3 = child3.nextSibling()) {
-                                                        if (auto child3E = child3.toElement();
-                                                            !child3E.isNull() && child3E.tagName() == "measurement") {
-                                                            uint32_t uops = child3E.attribute("uops").toUInt();
-                                                            QString ports = child3E.attribute("ports");
-
-                                                            float throughput = (child3E.hasAttribute("TP")) ?
-                                                                child3E.attribute("TP").toFloat() :
-                                                                child3E.attribute("TP_unrolled").toFloat();
-
-                                                            // Calculate latency
-                                                            uint32_t latency = UINT_MAX;
-                                                            uint32_t latencyTrue = UINT_MAX;
-                                                            uint32_t latencyMemory =
-                                                                UINT_MAX; // Additional latency associated
-                                                                          // with using a memory address
-                                                            for (auto child4 = child3.firstChild(); !child4.isNull();
-                                                                 child4 = child4.nextSibling()) {
-                                                                if (auto child4E = child4.toElement();
-                                                                    !child4E.isNull() &&
-                                                                    child4E.tagName() == "latency") {
-                                                                    if (child4E.hasAttribute("cycles")) {
-                                                                        if (child4E.attribute("target_op").toUInt() ==
-                                                                                1 &&
-                                                                            child4E.attribute("start_op").toUInt() ==
-                                                                                1 &&
-                                                                            child4E.attribute("cycles").toUInt() > 0) {
-                                                                            latencyTrue =
-                                                                                child4E.attribute("cycles").toUInt();
-                                                                        } else {
-                                                                            latency = std::max(
-                                                                                latency == UINT_MAX ? 0 : latency,
-                                                                                child4E.attribute("cycles").toUInt());
-                                                                        }
-                                                                    } else if (child4E.hasAttribute("cycles_mem")) {
-                                                                        latencyMemory = std::max(
-                                                                            latencyMemory == UINT_MAX ? 0 :
-                                                                                                        latencyMemory,
-                                                                            child4E.attribute("cycles_mem").toUInt());
-                                                                        latencyMemory = std::max(latencyMemory,
-                                                                            child4E.attribute("cycles_addr").toUInt());
-                                                                    }
-                                                                }
-                                                            }
-
-                                                            // Fix latency for cases when different operand ordering
-                                                            // resulted in different results
-                                                            if (latencyTrue != UINT_MAX) {
-                                                                latency = latencyTrue;
-                                                            }
-                                                            // Fix if only memory latency is provided
-                                                            if (latency == UINT_MAX) {
-                                                                std::swap(latency, latencyMemory);
-                                                            }
-
-                                                            // Add to list
-                                                            measurements.emplaceBack(std::move(archPretty), latency,
-                                                                latencyMemory, throughput, uops, std::move(ports));
-                                                            break;
-                                                        }
-                                                    }
-                                                }
-                                            }
-
-                                            // Check if shutdown has been called
-                                            if (parentApp->getLoaded()) {
-                                                return false;
-                                            }
-                                            break;
-                                        }
-                                    }
-                                }
-                            }
-                        }
-                    }
-                    if (secondLoop) {
-                        // Fix for known broken xed lookups
-                        bool repeat = false;
-                        for (auto& xed : xeds) {
-                            if (auto replace = xedConversions.constFind(xed); replace != xedConversions.constEnd()) {
-                                xed = replace.value();
-                                repeat = true;
-                            }
-                        }
-                        if (repeat) {
-                            secondLoop = false;
-                            continue;
+    // Finds the first instruction in document order that matches any of the xeds. If an extension is passed then only
+    // instructions listed under an extension starting with that name are considered.
+    const auto findUops = [&uopsIndex](const QList<QString>& xeds, const QString* extension) -> const UopsInstruction* {
+        const UopsInstruction* found = nullptr;
+        for (const auto& xed : xeds) {
+            if (auto entries = uopsIndex.constFind(xed); entries != uopsIndex.constEnd()) {
+                for (const auto& entry : *entries) {
+                    if (extension == nullptr || entry.extension.startsWith(*extension)) {
+                        if (found == nullptr || entry.order < found->order) {
+                            found = &entry;
                         }
                         break;
                     }
-                    // Go through the list a second time and this time skip checking the extension
-                    secondLoop = true;
-                }
-#ifdef _DEBUG
-                if (!found) {
-                    QString xedString;
-                    for (const auto& xed : xeds) {
-                        if (!xedString.isEmpty()) {
-                            xedString += '|';
-                        }
-                        xedString += xed;
-                    }
-                    qDebug() << "Intrinsic uops data not found: " + name + ", xed: " + xedString;
                 }
-#endif
-            } else {
-#ifdef _DEBUG
-                qDebug() << "Intrinsic element in xml file did not have xed element: " + name;
-#endif
             }
+        }
+        return found;
+    };
 
-            // Check if has a valid technology (added in newer version of intrinsic format)
-            // TODO: Add tree structure by combining techs with cpuid sub tree
-            if (tech.contains("_ALL")) {
-#ifdef _DEBUG
-                if (cpuids.length() != 1) {
-                    qDebug() << "Intrinsic technology value did not map to single cpuid: " + name;
-                }
-#endif
-                tech = cpuids[0];
-            }
-            if (tech.startsWith("AVX_") || tech == "SHA512" || tech == "SM3" || tech == "SM4") {
-                tech = "Other";
-            }
+    // Each distinct technology/type/category is found using a hash set instead of searching the lists
+    QSet<QString> seenTechnologies;
+    QSet<QString> seenTypes;
+    QSet<QString> seenCategories;
+    const auto addKnown = [](QSet<QString>& seen, QList<QString>& all, const QString& item) {
+        if (!seen.contains(item)) {
+            seen.insert(item);
+            all.append(item);
+        }
+    };
 
-            // Add to list of known techs/types
-            if (!data.allTechnologies.contains(tech)) {
-                data.allTechnologies.append(tech);
-            }
-            for (auto& j : types) {
-                if (!data.allTypes.contains(j)) {
-                    data.allTypes.append(j);
-                }
-            }
-            for (auto& j : categories) {
-                if (!data.allCategories.contains(j)) {
-                    data.allCategories.append(j);
-                }
+    // Add the uops measurements to each intrinsic
+    for (auto& i : instructions) {
+        if (!i.xeds.isEmpty()) {
+            // Search the matching extension first and then fall back to any extension
+            const UopsInstruction* entry = findUops(i.xeds, &i.extension);
+            if (entry == nullptr) {
+                entry = findUops(i.xeds, nullptr);
             }
-
-            // Generate pretty display name for intrinsic
-            // TODO: Allow for theme specific styling
-            QString fullName = "<font color=\"mediumpurple\">";
-            fullName += returnParam;
-            fullName += "</font>";
-            fullName += ' ';
-            fullName += name;
-            fullName += " (";
-            bool first = false;
-            for (auto& [parType, parName] : parameters) {
-                if (first) {
-                    fullName += ", ";
+            if (entry == nullptr) {
+                // Fix for known broken xed lookups
+                bool repeat = false;
+                for (auto& xed : i.xeds) {
+                    if (auto replace = xedConversions.constFind(xed); replace != xedConversions.constEnd()) {
+                        xed = replace.value();
+                        repeat = true;
+                    }
                 }
-                fullName += "<font color=\"mediumpurple\">";
-                fullName += parType;
-                fullName += "</font>";
-                QString parNameStyled = "<font color=\"lightseagreen\">";
-                parNameStyled += parName;
-                parNameStyled += "</font>";
-                fullName += ' ' + parNameStyled;
-                first = true;
-                description.replace('"' + parName + '"', parNameStyled);
-            }
-            fullName += ')';
-
-            // Also update descriptions return variable
-            QString parNameStyled = "<font color=\"lightseagreen\">";
-            parNameStyled += returnName;
-            parNameStyled += "</font>";
-            description.replace('"' + returnName + '"', parNameStyled);
-
-            // Create print friendly text
-            QString cpuidText, typesText, catText;
-            for (auto& j : cpuids) {
-                if (!cpuidText.isEmpty()) {
-                    cpuidText += ", ";
+                if (repeat) {
+                    entry = findUops(i.xeds, &i.extension);
+                    if (entry == nullptr) {
+                        entry = findUops(i.xeds, nullptr);
+                    }
                 }
-                cpuidText += j;
             }
-            for (auto& j : types) {
-                if (!typesText.isEmpty()) {
-                    typesText += ", ";
-                }
-                typesText += j;
+            if (entry != nullptr) {
+                i.measurements = entry->measurements;
             }
-            for (auto& j : categories) {
-                if (!catText.isEmpty()) {
-                    catText += ", ";
+#ifdef _DEBUG
+            if (entry == nullptr) {
+                QString xedString;
+                for (const auto& xed : i.xeds) {
+                    if (!xedString.isEmpty()) {
+                        xedString += '|';
+                    }
+                    xedString += xed;
                 }
-                catText += j;
+                qDebug() << "Intrinsic uops data not found: " + i.name + ", xed: " + xedString;
             }
+#endif
+        } else {
+#ifdef _DEBUG
+            qDebug() << "Intrinsic element in xml file did not have xed element: " + i.name;
+#endif
+        }
 
-            // Add information to list
-            instructions.emplaceBack(std::move(fullName), std::move(name), std::move(description), std::move(operation),
-                std::move(header), std::move(cpuidText), std::move(typesText), std::move(catText), std::move(tech),
-                std::move(types), std::move(categories), std::move(instruction), std::move(measurements));
+        // Add to list of known techs/types
+        addKnown(seenTechnologies, data.allTechnologies, i.technology);
+        for (auto& j : i.types) {
+            addKnown(seenTypes, data.allTypes, j);
+        }
+        for (auto& j : i.categories) {
+            addKnown(seenCategories, data.allCategories, j);
+        }
 
-            // Check if shutdown has been called
-            if (parentApp->getLoaded()) {
-                return false;
-            }
+        // Check if shutdown has been called
+        if (parentApp->getShutdown()) {
+            return false;
         }
     }
 
+    qInfo() << "Joined" << instructions.size() << "intrinsics with uops data in" << joinTimer.elapsed() << "ms";
     addProgress(1.0F);
 
     // Sort the 'all' lists
@@ -636,108 +530,499 @@ bool DataProvider::create() noexcept
         } else if (j.startsWith("AVX-512")) {
             auto find = sortTechnologies.indexOf("AMX");
             sortTechnologies.emplace(find, std::move(j));
-        } else if (!j.isEmpty()) {
+        } else {
             sortTechnologies.emplaceBack(std::move(j));
         }
     }
     data.allTechnologies.swap(sortTechnologies);
 
+    // Map each item to its final index once the lists are in their final order
+    const auto getIDs = [](const QList<QString>& all) {
+        QHash<QString, uint32_t> ret;
+        ret.reserve(all.size());
+        for (qsizetype i = 0; i < all.size(); ++i) {
+            ret.insert(all[i], static_cast<uint32_t>(i));
+        }
+        return ret;
+    };
+    const QHash<QString, uint32_t> technologyIDs = getIDs(data.allTechnologies);
+    const QHash<QString, uint32_t> typeIDs = getIDs(data.allTypes);
+    const QHash<QString, uint32_t> categoryIDs = getIDs(data.allCategories);
+
     // Generate indexes for stored instructions
     for (auto& i : instructions) {
-        const auto tech = static_cast<uint32_t>(data.allTechnologies.indexOf(i.technology));
+        // Every item was added to the lists above so always has a valid index
+        const auto tech = technologyIDs.value(i.technology);
         QList<uint32_t> types, categories;
+        types.reserve(i.types.size());
+        categories.reserve(i.categories.size());
         for (auto& j : i.types) {
-            types.emplaceBack(static_cast<uint32_t>(data.allTypes.indexOf(j)));
+            types.emplaceBack(typeIDs.value(j));
         }
         for (auto& j : i.categories) {
-            categories.emplaceBack(static_cast<uint32_t>(data.allCategories.indexOf(j)));
+            categories.emplaceBack(categoryIDs.value(j));
         }
-        data.instructions.emplaceBack(std::move(i.fullName), std::move(i.name), std::move(i.description),
+        data.instructions.emplaceBack(std::move(i.signature), std::move(i.name), std::move(i.description),
             std::move(i.operation), std::move(i.header), std::move(i.cpuidText), std::move(i.typeText),
             std::move(i.categoryText), tech, std::move(types), std::move(categories), std::move(i.instruction),
             std::move(i.measurements));
     }
 
     std::sort(data.instructions.begin(), data.instructions.end());
+    return true;
+}
 
-#ifndef _DEBUG
-    // Delete old cache
-    if (QFile file(intrinFile); file.exists()) {
-        file.remove();
+bool DataProvider::parseIntrinsics(QIODevice& device, QList<Instruction>& instructions) noexcept
+{
+    const QMap<QString, QString>& typesPretty = InternalData::getTypeNames();
+
+    // Converts an element type into its display name, the declared type is used to resolve generic vector types
+    const auto prettyType = [&typesPretty](QString&& etype, const QString& type) {
+        QString pretty = typesPretty.contains(etype) ? typesPretty[etype] : std::move(etype);
+        if (pretty == "M128" || pretty == "M256" || pretty == "M512") {
+            if (type.contains("void")) {
+                pretty.clear();
+            } else if (type.contains("__m128i") || type.contains("__m256i") || type.contains("__m512i")) {
+                pretty = "Integer (variable)";
+            } else if (type.contains("__m128") || type.contains("__m256") || type.contains("__m512")) {
+                pretty = typesPretty["FP32"];
+            } else if (type.contains("__m128d") || type.contains("__m256d") || type.contains("__m512d")) {
+                pretty = typesPretty["FP64"];
+            } else if (type.contains("__m128h") || type.contains("__m256h") || type.contains("__m512h")) {
+                pretty = typesPretty["FP16"];
+            } else {
+#ifdef _DEBUG
+                qDebug() << "Unknown type: " << type;
+#endif
+                pretty = "";
+            }
+        }
+        return pretty;
+    };
+
+    QXmlStreamReader xml(&device);
+    if (!xml.readNextStartElement()) {
+        qCritical() << "Failed to parse XML: " << xml.errorString() << " (" << xml.lineNumber() << ", "
+                    << xml.columnNumber() << ")";
+        return false;
     }
-    if (QFile file(uopsFile); file.exists()) {
-        file.remove();
+
+    // The root element holds the data version
+    const QXmlStreamAttributes rootAttributes = xml.attributes();
+    data.version = rootAttributes.hasAttribute("version") ? rootAttributes.value("version").toString() : "3.6.7";
+    QDate currentDate = QDate::currentDate();
+    const QString date =
+        rootAttributes.hasAttribute("date") ? rootAttributes.value("date").toString() : currentDate.toString();
+    data.date = QDate::fromString(date, "MM/dd/yyyy");
+#ifdef _DEBUG
+    if (!data.date.isValid()) {
+        qDebug() << "Invalid source date detected for intrinsic guide data:" << date;
+        data.date = currentDate;
     }
 #endif
+    if (QDateTime(data.date, QTime::currentTime()).daysTo(QDateTime::currentDateTime()) > 180) {
+        qInfo() << "Upstream intrinsic guide data has not been updated in over 180 days. Setting cache date to current date";
+        data.date = currentDate;
+    }
 
-    return true;
-}
+    // The short text fields are heavily repeated so share a single copy of each
+    QSet<QString> stringPool;
+    const auto pool = [&stringPool](QString& string) {
+        if (const auto found = stringPool.constFind(string); found != stringPool.constEnd()) {
+            string = *found;
+        } else {
+            stringPool.insert(string);
+        }
+    };
 
-bool DataProvider::downloadCache(
-    const QString& fileName, const QString& name, QDomDocument& dataXML, const QUrl& url) noexcept
-{
-    // Check if cached xml file exists
-    if (QFile fileCache(fileName); fileCache.exists() && fileCache.open(QIODevice::ReadOnly)) {
-        parentApp->setLoadingTitle("Loading " + name + " from cache...");
-        addProgress(2.0F);
-        QString errorMessage;
-        int errorLine = -1, errorColumn = -1;
-        if (!dataXML.setContent(&fileCache, &errorMessage, &errorLine, &errorColumn)) {
-            qCritical() << "Failed to parse XML: " << errorMessage << " (" << errorLine << ", " << errorColumn << ")";
-            // Delete broken file cache
-            fileCache.remove();
-            parentApp->addOKDialog("Failed to pass " + name + " data", [] {});
-            return false;
+    // Loop through each element and get information
+    while (xml.readNextStartElement()) {
+        // Check if the child tag name is an 'intrinsic'
+        if (xml.name() != QLatin1StringView("intrinsic")) {
+            xml.skipCurrentElement();
+            continue;
         }
-    } else {
-        parentApp->setLoadingTitle("Downloading " + name + "...");
-        // Download intrinsic xml
-        Downloader dl([this](const float value) { setProgress(value); });
-        QByteArray dlData;
-        if (!dl.get(url, dlData) || dlData.isEmpty()) {
-            parentApp->addOKDialog("Failed to download " + name + " data", [] {});
-            return false;
+        // Get the intrinsic attributes
+        // tech: is Technologies selection where cpuids is subsection to tech (when not equal)
+        // types: is integer/floating point etc.
+        // name: is intrinsic name
+        // description: is text description of intrinsic operation
+        // operation: is pseudo code of intrinsic operation
+        // header: is the header file the intrinsic is declared in.
+        const QXmlStreamAttributes attributes = xml.attributes();
+        QString tech = attributes.hasAttribute("tech") ? attributes.value("tech").toString() : "Unknown";
+        QString name = attributes.value("name").toString();
+        if (name.isEmpty()) {
+#ifdef _DEBUG
+            qDebug() << "Intrinsic element in xml file did not have name attribute: line" << xml.lineNumber();
+#endif
+            xml.skipCurrentElement();
+            continue;
+        }
+        // Skip SVML as its intel compiler only
+        if (tech == "SVML" || tech == "KNC") {
+            xml.skipCurrentElement();
+            continue;
+        }
+        QList<QString> types, cpuids, categories, xeds;
+        QString description, operation, header, instruction;
+        QString returnParam, returnName;
+        QList<QPair<QString, QString>> parameters;
+        // Get each child nodes data
+        while (xml.readNextStartElement()) {
+            // Read Name and value
+            if (const QStringView tag = xml.name(); tag == QLatin1StringView("type")) {
+                // Can have multiple type nodes (e.g. Integer and Flag)
+                if (QString text = xml.readElementText(QXmlStreamReader::IncludeChildElements); !text.isEmpty()) {
+                    types.emplaceBack(std::move(text));
+                }
+            } else if (tag == QLatin1StringView("CPUID")) {
+                // Can have multiple cpuid nodes (e.g. different AVX512 sets)
+                if (QString text = xml.readElementText(QXmlStreamReader::IncludeChildElements); !text.isEmpty()) {
+                    cpuids.emplaceBack(std::move(text));
+                }
+            } else if (tag == QLatin1StringView("category")) {
+                if (QString text = xml.readElementText(QXmlStreamReader::IncludeChildElements); !text.isEmpty()) {
+                    categories.emplaceBack(std::move(text));
+                }
+            } else if (tag == QLatin1StringView("return")) {
+                // Has attributes for type, varname, etype
+                const QXmlStreamAttributes childAttributes = xml.attributes();
+                returnParam = childAttributes.value("type").toString();
+                returnName = childAttributes.value("varname").toString();
+                if (childAttributes.hasAttribute("etype")) {
+                    QString pretty = prettyType(childAttributes.value("etype").toString(), returnParam);
+                    if (!pretty.isEmpty() && !types.contains(pretty)) {
+                        types.emplaceBack(std::move(pretty));
+                    }
+                }
+                xml.skipCurrentElement();
+            } else if (tag == QLatin1StringView("parameter")) {
+                // Can have multiple parameters
+                // Has same attributes as 'return'
+                const QXmlStreamAttributes childAttributes = xml.attributes();
+                QString typeParam = childAttributes.value("type").toString();
+                QString nameParam = childAttributes.value("varname").toString();
+                if (childAttributes.hasAttribute("etype")) {
+                    if (QString etype = childAttributes.value("etype").toString(); etype != "IMM") {
+                        QString pretty = prettyType(std::move(etype), typeParam);
+                        if (!pretty.isEmpty() && !types.contains(pretty)) {
+                            types.emplaceBack(std::move(pretty));
+                        }
+                    }
+                }
+                parameters.emplaceBack(qMakePair(std::move(typeParam), std::move(nameParam)));
+                xml.skipCurrentElement();
+            } else if (tag == QLatin1StringView("description")) {
+                description = xml.readElementText(QXmlStreamReader::IncludeChildElements);
+            } else if (tag == QLatin1StringView("operation")) {
+                operation = xml.readElementText(QXmlStreamReader::IncludeChildElements).trimmed();
+            } else if (tag == QLatin1StringView("instruction")) {
+                // Has attributes xed, form, name
+                const QXmlStreamAttributes childAttributes = xml.attributes();
+                QString xed = childAttributes.value("xed").toString();
+                if (!xed.isEmpty() && !xeds.contains(xed)) {
+                    xeds.emplaceBack(std::move(xed));
+                }
+                if (!instruction.isEmpty()) {
+                    instruction += ',';
+                }
+                instruction += childAttributes.value("name");
+                xml.skipCurrentElement();
+            } else if (tag == QLatin1StringView("header")) {
+                header = xml.readElementText(QXmlStreamReader::IncludeChildElements);
+            } else {
+                xml.skipCurrentElement();
+            }
+        }
+        if (types.isEmpty()) {
+            types.append("Other");
         }
 
-        // Check if shutdown has been called
-        if (parentApp->getLoaded()) {
-            return false;
+        // uops info stores instructions by extension name (cpuid)
+        QString cpuid;
+        for (auto& j : cpuids) {
+            cpuid = j; // Generally the last one is fine
+        }
+        // Perform required conversions between intrinsic and uops arch names
+        if (cpuid == "ADX") {
+            cpuid = "ADOX_ADCX";
+        } else if (cpuid == "AVX2") {
+            // Allow searching through AVX subdomains
+            cpuid = "AVX";
+        } else if (cpuid.startsWith("AVX512")) {
+            // Allow searching through AVX512 subdomains
+            cpuid = "AVX512";
         }
-        addProgress(1.0F);
 
-        // Convert to xml
-        parentApp->setLoadingTitle("Converting " + name + "...");
-        QString errorMessage;
-        int errorLine = -1, errorColumn = -1;
-        if (!dataXML.setContent(dlData, &errorMessage, &errorLine, &errorColumn)) {
-            qCritical() << "Failed to parse XML: " << errorMessage << " (" << errorLine << ", " << errorColumn << ")";
+        // Check if has a valid technology (added in newer version of intrinsic format)
+        // TODO: Add tree structure by combining techs with cpuid sub tree
+        if (tech.contains("_ALL") && !cpuids.isEmpty()) {
+#ifdef _DEBUG
+            if (cpuids.length() != 1) {
+                qDebug() << "Intrinsic technology value did not map to single cpuid: " + name;
+            }
+#endif
+            tech = cpuids[0];
+        }
+        if (tech.isEmpty() || tech.startsWith("AVX_") || tech == "SHA512" || tech == "SM3" || tech == "SM4") {
+            tech = "Other";
+        }
 
-            parentApp->addOKDialog("Failed to pass " + name + " data", [] {});
-            return false;
+        // Only the parts of the signature are stored, the styled display text is created when displayed
+        QString signature = SignatureFormatter::encode(returnParam, returnName, parameters);
+
+        // Create print friendly text
+        QString cpuidText, typesText, catText;
+        for (auto& j : cpuids) {
+            if (!cpuidText.isEmpty()) {
+                cpuidText += ", ";
+            }
+            cpuidText += j;
         }
-        addProgress(1.0F);
+        for (auto& j : types) {
+            if (!typesText.isEmpty()) {
+                typesText += ", ";
+            }
+            typesText += j;
+        }
+        for (auto& j : categories) {
+            if (!catText.isEmpty()) {
+                catText += ", ";
+            }
+            catText += j;
+        }
+
+        pool(header);
+        pool(cpuidText);
+        pool(typesText);
+        pool(catText);
+
+        // Add information to list
+        instructions.emplaceBack(std::move(signature), std::move(name), std::move(description), std::move(operation),
+            std::move(header), std::move(cpuidText), std::move(typesText), std::move(catText), std::move(tech),
+            std::move(types), std::move(categories), std::move(instruction), std::move(xeds), std::move(cpuid));
 
         // Check if shutdown has been called
-        if (parentApp->getLoaded()) {
+        if (parentApp->getShutdown()) {
             return false;
         }
+    }
+
+    if (xml.hasError()) {
+        qCritical() << "Failed to parse XML: " << xml.errorString() << " (" << xml.lineNumber() << ", "
+                    << xml.columnNumber() << ")";
+        return false;
+    }
+    return true;
+}
+
+bool DataProvider::parseUops(QIODevice& device, UopsIndex& index) noexcept
+{
+    const QMap<QString, QString> archsPretty = {
+        {  "CON",              "Conroe"},
+        {  "WOL",            "Wolfdale"},
+        {  "NHM",             "Nehalem"},
+        {  "WSM",            "Westmere"},
+        {  "SNB",        "Sandy Bridge"},
+        {  "IVB",          "Ivy Bridge"},
+        {  "HSW",             "Haswell"},
+        {  "BDW",           "Broadwell"},
+        {  "SKL",             "Skylake"},
+        {  "SKX",           "Skylake-X"},
+        {  "KBL",           "Kaby Lake"},
+        {  "CFL",         "Coffee Lake"},
+        {  "CNL",         "Cannon Lake"},
+        {  "CLX",        "Cascade Lake"},
+        {  "ICL",            "Ice Lake"},
+        {  "TGL",          "Tiger Lake"},
+        {  "RKL",         "Rocket Lake"},
+        { "ZEN+",                "Zen+"},
+        { "ZEN2",                "Zen2"},
+        { "ZEN3",                "Zen3"},
+        { "ZEN4",                "Zen4"},
+        { "ZEN5",                "Zen5"},
+        {"ADL-P", "Alder Lake (P-Core)"},
+        {"ADL-E", "Alder Lake (E-Core)"},
+        {  "BNL",             "Bonnell"},
+        {  "AMT",             "Airmont"},
+        {  "GLM",            "Goldmont"},
+        {  "GLP",           "Goldmont+"},
+        {  "TRM",             "Tremont"}
+    };
+
+    QXmlStreamReader xml(&device);
+    if (!xml.readNextStartElement()) {
+        qCritical() << "Failed to parse XML: " << xml.errorString() << " (" << xml.lineNumber() << ", "
+                    << xml.columnNumber() << ")";
+        return false;
+    }
 
-        // Write out file to disk
-        parentApp->setLoadingTitle("Adding " + name + " to cache...");
-        if (!fileCache.open(QIODevice::WriteOnly | QIODevice::Text)) {
-            qWarning() << "Failed to write XML cache: " + fileName;
+    // Architecture and port strings are heavily repeated so share a single copy of each
+    QSet<QString> stringPool;
+    const auto pool = [&stringPool](QString& string) {
+        if (const auto found = stringPool.constFind(string); found != stringPool.constEnd()) {
+            string = *found;
         } else {
-            QTextStream stream(&fileCache);
-            stream << dataXML.toString();
-            fileCache.close();
+            stringPool.insert(string);
+        }
+    };
+    uint32_t order = 0;
+    while (xml.readNextStartElement()) {
+        // uops info stores instructions by extension name (cpuid)
+        if (xml.name() != QLatin1StringView("extension")) {
+            xml.skipCurrentElement();
+            continue;
+        }
+        const QString extension = xml.attributes().value("name").toString();
+        while (xml.readNextStartElement()) {
+            if (xml.name() != QLatin1StringView("instruction")) {
+                xml.skipCurrentElement();
+                continue;
+            }
+            const QString iform = xml.attributes().value("iform").toString();
+            UopsInstruction instruction{extension, order++, {}};
+            while (xml.readNextStartElement()) {
+                if (xml.name() != QLatin1StringView("architecture")) {
+                    xml.skipCurrentElement();
+                    continue;
+                }
+                QString arch = xml.attributes().value("name").toString();
+                QString archPretty = archsPretty.contains(arch) ? archsPretty[arch] : std::move(arch);
+                pool(archPretty);
+                // Only the first measurement of each architecture is used
+                bool measured = false;
+                while (xml.readNextStartElement()) {
+                    if (measured || xml.name() != QLatin1StringView("measurement")) {
+                        xml.skipCurrentElement();
+                        continue;
+                    }
+                    measured = true;
+                    const QXmlStreamAttributes attributes = xml.attributes();
+                    uint32_t uops = attributes.value("uops").toUInt();
+                    QString ports = attributes.value("ports").toString();
+                    pool(ports);
+
+                    float throughput = attributes.hasAttribute("TP") ? attributes.value("TP").toFloat() :
+                                                                       attributes.value("TP_unrolled").toFloat();
+
+                    // Calculate latency
+                    uint32_t latency = UINT_MAX;
+                    uint32_t latencyTrue = UINT_MAX;
+                    uint32_t latencyMemory = UINT_MAX; // Additional latency associated with using a memory address
+                    while (xml.readNextStartElement()) {
+                        if (xml.name() == QLatin1StringView("latency")) {
+                            const QXmlStreamAttributes latencyAttributes = xml.attributes();
+                            if (latencyAttributes.hasAttribute("cycles")) {
+                                const uint32_t cycles = latencyAttributes.value("cycles").toUInt();
+                                if (latencyAttributes.value("target_op").toUInt() == 1 &&
+                                    latencyAttributes.value("start_op").toUInt() == 1 && cycles > 0) {
+                                    latencyTrue = cycles;
+                                } else {
+                                    latency = std::max(latency == UINT_MAX ? 0 : latency, cycles);
+                                }
+                            } else if (latencyAttributes.hasAttribute("cycles_mem")) {
+                                latencyMemory = std::max(latencyMemory == UINT_MAX ? 0 : latencyMemory,
+                                    latencyAttributes.value("cycles_mem").toUInt());
+                                latencyMemory =
+                                    std::max(latencyMemory, latencyAttributes.value("cycles_addr").toUInt());
+                            }
+                        }
+                        xml.skipCurrentElement();
+                    }
+
+                    // Fix latency for cases when different operand ordering resulted in different results
+                    if (latencyTrue != UINT_MAX) {
+                        latency = latencyTrue;
+                    }
+                    // Fix if only memory latency is provided
+                    if (latency == UINT_MAX) {
+                        std::swap(latency, latencyMemory);
+                    }
+
+                    // Add to list
+                    instruction.measurements.emplaceBack(
+                        std::move(archPretty), latency, latencyMemory, throughput, uops, std::move(ports));
+                }
+            }
+            // Entries are appended in document order so the first match of each iform is always found first
+            index[iform].emplaceBack(std::move(instruction));
         }
 
         // Check if shutdown has been called
-        if (parentApp->getLoaded()) {
+        if (parentApp->getShutdown()) {
             return false;
         }
     }
 
-    addProgress(1.0F);
+    if (xml.hasError()) {
+        qCritical() << "Failed to parse XML: " << xml.errorString() << " (" << xml.lineNumber() << ", "
+                    << xml.columnNumber() << ")";
+        return false;
+    }
+    return true;
+}
+
+int32_t DataProvider::startCache(
+    Downloader& dl, const QString& fileName, const QString& name, const QUrl& url) noexcept
+{
+    // Check if cached xml file exists
+    if (QFileInfo file(fileName); file.exists()) {
+        parentApp->setLoadingTitle("Loading " + name + " from cache...");
+        // A file provided without validators (e.g. when building the embedded data) is at least as new as the upstream
+        // data at the time it was written, so that time can still be used to later check for changes
+        if (const QString key = url.toString(); !data.validators.contains(key)) {
+            data.validators[key] = SourceValidator(QByteArray(), toHttpDate(file.lastModified()));
+        }
+        addProgress(2.0F);
+        return -1;
+    }
+    parentApp->setLoadingTitle("Downloading " + name + "...");
+    ++downloadCount;
+    // The data is written straight to the cache file as it arrives
+    return static_cast<int32_t>(dl.add(url, fileName));
+}
+
+SourceValidator DataProvider::getValidator(const QUrl& url) const noexcept
+{
+    SourceValidator validator = data.validators.value(url.toString());
+    // Data stored without validators can still be checked against the date it was created from
+    if (validator.eTag.isEmpty() && validator.lastModified.isEmpty() && dataset != nullptr &&
+        dataset->getDate().isValid()) {
+        validator.lastModified = toHttpDate(dataset->getDate().startOfDay(QTimeZone::utc()));
+    }
+    return validator;
+}
+
+QByteArray DataProvider::toHttpDate(const QDateTime& time) noexcept
+{
+    // HTTP dates are always in GMT using English day and month names
+    return QLocale::c().toString(time.toUTC(), "ddd, dd MMM yyyy hh:mm:ss 'GMT'").toLatin1();
+}
+
+bool DataProvider::finishCache(
+    Downloader& dl, const int32_t id, const QString& fileName, const QString& name, const QUrl& url) noexcept
+{
+    if (id < 0) {
+        return true;
+    }
+    // Wait for the download, any other downloads continue in the background
+    parentApp->setLoadingTitle("Downloading " + name + "...");
+    const bool success = dl.wait(static_cast<uint32_t>(id));
+
+    // Check if shutdown has been called, this also abandons the download
+    if (parentApp->getShutdown()) {
+        return false;
+    }
+
+    if (!success || QFileInfo(fileName).size() == 0) {
+        QFile::remove(fileName);
+        parentApp->addOKDialog("Failed to download " + name + " data", [] {});
+        return false;
+    }
+
+    // Keep the validators so that the source can later be checked for changes without downloading it again
+    const auto download = static_cast<uint32_t>(id);
+    data.validators[url.toString()] = SourceValidator(dl.getETag(download), dl.getLastModified(download));
     return true;
 }
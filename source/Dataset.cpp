@@ -0,0 +1,559 @@
+/**
+ * Copyright Matthew Oliver
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Dataset.h"
+
+#include <QHash>
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <numeric>
+
+constexpr uint32_t fileVersion = 0x020600;
+constexpr qsizetype maxCachedDetailBlocks = 8;
+constexpr uint32_t fileID = 0xA654BE39;
+constexpr uint32_t blockSize = 128 * 1024;
+
+// Tables are written back to back so every record must only require 4 byte alignment
+static_assert(sizeof(Dataset::Header) % sizeof(uint64_t) == 0);
+static_assert(alignof(Dataset::InstructionRecord) == sizeof(uint32_t));
+static_assert(alignof(Dataset::MeasurementRecord) == sizeof(uint32_t));
+static_assert(alignof(Dataset::StringRef) == sizeof(uint32_t));
+static_assert(alignof(Dataset::TextRef) == sizeof(uint32_t));
+
+std::shared_ptr<Dataset> Dataset::open(const QString& fileName) noexcept
+{
+    std::shared_ptr<Dataset> dataset(new Dataset());
+    dataset->file.setFileName(fileName);
+    if (!dataset->file.open(QIODevice::ReadOnly)) {
+        return nullptr;
+    }
+    dataset->size = dataset->file.size();
+    if (dataset->size < static_cast<qint64>(sizeof(Header))) {
+        qWarning() << "Cached data file is truncated";
+        return nullptr;
+    }
+    // Map the file so that the data is used in place and shared with the OS page cache
+    dataset->base = dataset->file.map(0, dataset->size);
+    if (dataset->base == nullptr) {
+        // Some files (e.g. compressed resources) cannot be mapped so read them instead
+        dataset->buffer = dataset->file.readAll();
+        if (dataset->buffer.size() != dataset->size) {
+            qWarning() << "Failed to read cached data file: " << dataset->file.errorString();
+            return nullptr;
+        }
+        dataset->base = reinterpret_cast<const uchar*>(dataset->buffer.constData());
+    }
+    if (const auto head = reinterpret_cast<const Header*>(dataset->base);
+        head->fileID == fileID && head->fileVersion == fileVersion && head->blockSize != 0 &&
+        !dataset->decompress()) {
+        qWarning() << "Cached data file is corrupt";
+        return nullptr;
+    }
+    if (!dataset->validate()) {
+        return nullptr;
+    }
+    return dataset;
+}
+
+std::shared_ptr<Dataset> Dataset::open(QByteArray&& buffer) noexcept
+{
+    std::shared_ptr<Dataset> dataset(new Dataset());
+    dataset->buffer = std::forward<QByteArray>(buffer);
+    dataset->base = reinterpret_cast<const uchar*>(dataset->buffer.constData());
+    dataset->size = dataset->buffer.size();
+    if (dataset->size < static_cast<qint64>(sizeof(Header)) || !dataset->validate()) {
+        return nullptr;
+    }
+    return dataset;
+}
+
+QByteArray Dataset::build(const InternalData& data) noexcept
+{
+    QList<InstructionRecord> instructionRecords;
+    QList<MeasurementRecord> measurementRecords;
+    QList<uint32_t> indexTable;
+    QList<StringRef> stringRefTable;
+    QString stringTable;
+    QByteArray textTable;
+    QByteArray detailTable;
+    instructionRecords.reserve(data.instructions.size());
+
+    const auto addString = [&stringTable](const QString& string) {
+        const StringRef ret{static_cast<uint32_t>(stringTable.size()), static_cast<uint32_t>(string.size())};
+        stringTable += string;
+        return ret;
+    };
+    const auto addText = [](QByteArray& table, const QString& text) {
+        const QByteArray utf8 = text.toUtf8();
+        const TextRef ret{static_cast<uint32_t>(table.size()), static_cast<uint32_t>(utf8.size())};
+        table += utf8;
+        return ret;
+    };
+    // Short strings repeated across many records are only stored once and then shared by every reference to them
+    QHash<QString, StringRef> stringPool;
+    const auto addPooledString = [&stringPool, &addString](const QString& string) {
+        if (const auto found = stringPool.constFind(string); found != stringPool.constEnd()) {
+            return *found;
+        }
+        const StringRef ret = addString(string);
+        stringPool.insert(string, ret);
+        return ret;
+    };
+    const auto addStrings = [&stringRefTable, &addString](const QList<QString>& strings) {
+        const RangeRef ret{static_cast<uint32_t>(stringRefTable.size()), static_cast<uint32_t>(strings.size())};
+        for (const auto& i : strings) {
+            stringRefTable.emplaceBack(addString(i));
+        }
+        return ret;
+    };
+    const auto addIndices = [&indexTable](const QList<uint32_t>& indices) {
+        const RangeRef ret{static_cast<uint32_t>(indexTable.size()), static_cast<uint32_t>(indices.size())};
+        indexTable.append(indices);
+        return ret;
+    };
+
+    Header head;
+    head.fileID = fileID;
+    head.fileVersion = fileVersion;
+    head.date = data.date.toJulianDay();
+    head.version = addString(data.version);
+    head.technologies = addStrings(data.allTechnologies);
+    head.types = addStrings(data.allTypes);
+    head.categories = addStrings(data.allCategories);
+    QList<QString> validators;
+    for (auto i = data.validators.cbegin(); i != data.validators.cend(); ++i) {
+        validators.emplaceBack(i.key());
+        validators.emplaceBack(QString::fromLatin1(i.value().eTag));
+        validators.emplaceBack(QString::fromLatin1(i.value().lastModified));
+    }
+    head.validators = addStrings(validators);
+
+    // Architecture and port names repeat across many measurements so each distinct name is only stored once
+    QList<QString> architectures;
+    QList<QString> ports;
+    QHash<QString, uint32_t> portIDs;
+    for (const auto& i : data.instructions) {
+        for (const auto& j : i.measurements) {
+            architectures.emplaceBack(j.arch);
+            if (!portIDs.contains(j.ports)) {
+                portIDs.insert(j.ports, static_cast<uint32_t>(ports.size()));
+                ports.emplaceBack(j.ports);
+            }
+        }
+    }
+    architectures.sort();
+    architectures.erase(std::unique(architectures.begin(), architectures.end()), architectures.end());
+    QHash<QString, uint32_t> archIDs;
+    for (qsizetype i = 0; i < architectures.size(); ++i) {
+        archIDs.insert(architectures[i], static_cast<uint32_t>(i));
+    }
+    head.architectures = addStrings(architectures);
+    head.ports = addStrings(ports);
+
+    for (const auto& i : data.instructions) {
+        InstructionRecord record;
+        record.signature = addText(textTable, i.signature);
+        record.name = addString(i.name);
+        record.description = addText(detailTable, i.description);
+        record.operation = addText(detailTable, i.operation);
+        record.header = addPooledString(i.header);
+        record.cpuidText = addPooledString(i.cpuidText);
+        record.typeText = addPooledString(i.typeText);
+        record.categoryText = addPooledString(i.categoryText);
+        record.instruction = addString(i.instruction);
+        record.technology = i.technology;
+        record.types = addIndices(i.types);
+        record.categories = addIndices(i.categories);
+        record.measurements = {static_cast<uint32_t>(measurementRecords.size()),
+            static_cast<uint32_t>(i.measurements.size())};
+        for (const auto& j : i.measurements) {
+            measurementRecords.emplaceBack(MeasurementRecord{
+                archIDs.value(j.arch), j.latency, j.latencyMem, j.throughput, j.uops, portIDs.value(j.ports)});
+        }
+        instructionRecords.emplaceBack(record);
+    }
+
+    // Layout each table one after the other, every table starts with 4 byte alignment
+    head.instructionCount = static_cast<uint32_t>(instructionRecords.size());
+    head.instructions = sizeof(Header);
+    head.measurementCount = static_cast<uint32_t>(measurementRecords.size());
+    head.measurements = head.instructions + head.instructionCount * sizeof(InstructionRecord);
+    head.indexCount = static_cast<uint32_t>(indexTable.size());
+    head.indices = head.measurements + head.measurementCount * sizeof(MeasurementRecord);
+    head.stringRefCount = static_cast<uint32_t>(stringRefTable.size());
+    head.stringRefs = head.indices + head.indexCount * sizeof(uint32_t);
+    head.stringLength = static_cast<uint32_t>(stringTable.size());
+    head.strings = head.stringRefs + head.stringRefCount * sizeof(StringRef);
+    const uint32_t stringsEnd = head.strings + head.stringLength * static_cast<uint32_t>(sizeof(char16_t));
+    head.textLength = static_cast<uint32_t>(textTable.size());
+    head.texts = (stringsEnd + 3) & ~3U;
+    const uint32_t textsEnd = head.texts + head.textLength;
+    head.detailLength = static_cast<uint32_t>(detailTable.size());
+    head.details = (textsEnd + 3) & ~3U;
+
+    QByteArray ret;
+    ret.reserve(head.details + head.detailLength);
+    ret.append(reinterpret_cast<const char*>(&head), sizeof(Header));
+    ret.append(reinterpret_cast<const char*>(instructionRecords.constData()),
+        head.instructionCount * sizeof(InstructionRecord));
+    ret.append(reinterpret_cast<const char*>(measurementRecords.constData()),
+        head.measurementCount * sizeof(MeasurementRecord));
+    ret.append(reinterpret_cast<const char*>(indexTable.constData()), head.indexCount * sizeof(uint32_t));
+    ret.append(reinterpret_cast<const char*>(stringRefTable.constData()), head.stringRefCount * sizeof(StringRef));
+    ret.append(reinterpret_cast<const char*>(stringTable.constData()), head.stringLength * sizeof(char16_t));
+    ret.append(QByteArray(static_cast<qsizetype>(head.texts - stringsEnd), '\0'));
+    ret.append(textTable);
+    ret.append(QByteArray(static_cast<qsizetype>(head.details - textsEnd), '\0'));
+    ret.append(detailTable);
+    return ret;
+}
+
+QByteArray Dataset::compress(const QByteArray& data) noexcept
+{
+    Header head;
+    memcpy(&head, data.constData(), sizeof(Header));
+    head.blockSize = blockSize;
+    head.blockCount = (head.textLength + blockSize - 1) / blockSize;
+    // The detail table is compressed separately so that its blocks never contain any of the text table
+    head.detailBlockCount = (head.detailLength + blockSize - 1) / blockSize;
+    const uint32_t blockTotal = head.blockCount + head.detailBlockCount;
+
+    // Each block is compressed independently so that they can later be decompressed in parallel
+    QList<uint32_t> blockIDs(blockTotal);
+    std::iota(blockIDs.begin(), blockIDs.end(), 0);
+    const auto blocks = QtConcurrent::blockingMapped<QList<QByteArray>>(blockIDs, [&data, &head](const uint32_t block) {
+        const auto source = reinterpret_cast<const uchar*>(data.constData());
+        if (block >= head.blockCount) {
+            const uint32_t offset = (block - head.blockCount) * blockSize;
+            return qCompress(source + head.details + offset, std::min(blockSize, head.detailLength - offset));
+        }
+        const uint32_t offset = block * blockSize;
+        return qCompress(source + head.texts + offset, std::min(blockSize, head.textLength - offset));
+    });
+
+    // All tables before the text table are stored unchanged so that they can still be used in place, the block index
+    // then replaces the text table
+    QList<BlockRecord> blockIndex;
+    blockIndex.reserve(blockTotal);
+    uint32_t offset = head.texts + blockTotal * sizeof(BlockRecord);
+    for (const auto& i : blocks) {
+        blockIndex.emplaceBack(BlockRecord{offset, static_cast<uint32_t>(i.size())});
+        offset += static_cast<uint32_t>(i.size());
+    }
+
+    QByteArray ret;
+    ret.reserve(offset);
+    ret.append(reinterpret_cast<const char*>(&head), sizeof(Header));
+    ret.append(data.constData() + sizeof(Header), head.texts - sizeof(Header));
+    ret.append(reinterpret_cast<const char*>(blockIndex.constData()), blockTotal * sizeof(BlockRecord));
+    for (const auto& i : blocks) {
+        ret.append(i);
+    }
+    return ret;
+}
+
+bool Dataset::updateDate(const QString& fileName, const QDate& date) noexcept
+{
+    if (QFile fileCache(fileName); fileCache.open(QIODevice::ReadWrite)) {
+        Header head;
+        if (fileCache.read(reinterpret_cast<char*>(&head), sizeof(Header)) != sizeof(Header) ||
+            head.fileID != fileID || head.fileVersion != fileVersion) {
+            return false;
+        }
+        const int64_t julian = date.toJulianDay();
+        return fileCache.seek(offsetof(Header, date)) &&
+            fileCache.write(reinterpret_cast<const char*>(&julian), sizeof(julian)) == sizeof(julian);
+    }
+    return false;
+}
+
+QDate Dataset::getDate() const noexcept
+{
+    return QDate::fromJulianDay(header->date);
+}
+
+QStringView Dataset::getVersion() const noexcept
+{
+    return getString(header->version);
+}
+
+QList<QString> Dataset::getTechnologies() const noexcept
+{
+    return getStrings(header->technologies);
+}
+
+QList<QString> Dataset::getTypes() const noexcept
+{
+    return getStrings(header->types);
+}
+
+QList<QString> Dataset::getCategories() const noexcept
+{
+    return getStrings(header->categories);
+}
+
+QList<QString> Dataset::getArchitectures() const noexcept
+{
+    return getStrings(header->architectures);
+}
+
+QStringView Dataset::getArchitecture(const uint32_t arch) const noexcept
+{
+    return getString(stringRefs[header->architectures.offset + arch]);
+}
+
+QStringView Dataset::getPorts(const uint32_t ports) const noexcept
+{
+    return getString(stringRefs[header->ports.offset + ports]);
+}
+
+QMap<QString, SourceValidator> Dataset::getValidators() const noexcept
+{
+    QMap<QString, SourceValidator> ret;
+    for (uint32_t i = header->validators.offset; i + 2 < header->validators.offset + header->validators.count;
+         i += 3) {
+        ret.insert(getString(stringRefs[i]).toString(),
+            SourceValidator(getString(stringRefs[i + 1]).toLatin1(), getString(stringRefs[i + 2]).toLatin1()));
+    }
+    return ret;
+}
+
+uint32_t Dataset::getInstructionCount() const noexcept
+{
+    return header->instructionCount;
+}
+
+const Dataset::InstructionRecord& Dataset::getInstruction(const uint32_t index) const noexcept
+{
+    return instructions[index];
+}
+
+const Dataset::MeasurementRecord& Dataset::getMeasurement(const uint32_t index) const noexcept
+{
+    return measurements[index];
+}
+
+uint32_t Dataset::getIndex(const uint32_t index) const noexcept
+{
+    return indices[index];
+}
+
+QStringView Dataset::getString(const StringRef& string) const noexcept
+{
+    return {strings + string.offset, static_cast<qsizetype>(string.length)};
+}
+
+QString Dataset::getText(const TextRef& text) const noexcept
+{
+    return QString::fromUtf8(texts + text.offset, static_cast<qsizetype>(text.length));
+}
+
+QString Dataset::getDetail(const TextRef& text) const noexcept
+{
+    if (details != nullptr) {
+        return QString::fromUtf8(details + text.offset, static_cast<qsizetype>(text.length));
+    }
+
+    // Texts may span multiple blocks so each required part is copied out of its block
+    QMutexLocker lock(&detailMutex);
+    QByteArray utf8;
+    utf8.reserve(text.length);
+    const uint64_t end = static_cast<uint64_t>(text.offset) + text.length;
+    for (uint64_t start = text.offset; start < end;) {
+        const auto block = static_cast<uint32_t>(start / header->blockSize);
+        const QByteArray data = getDetailBlock(block);
+        const uint64_t blockStart = static_cast<uint64_t>(block) * header->blockSize;
+        const uint64_t blockEnd = std::min(end, blockStart + header->blockSize);
+        if (static_cast<uint64_t>(data.size()) < blockEnd - blockStart) {
+            return {};
+        }
+        utf8.append(data.constData() + (start - blockStart), static_cast<qsizetype>(blockEnd - start));
+        start = blockEnd;
+    }
+    return QString::fromUtf8(utf8);
+}
+
+bool Dataset::decompress() noexcept
+{
+    const auto head = reinterpret_cast<const Header*>(base);
+    const uint64_t blockTotal = static_cast<uint64_t>(head->blockCount) + head->detailBlockCount;
+    if (head->texts < sizeof(Header) || head->texts % alignof(BlockRecord) != 0 ||
+        static_cast<uint64_t>(head->texts) + blockTotal * sizeof(BlockRecord) > static_cast<uint64_t>(size) ||
+        head->textLength > static_cast<uint64_t>(head->blockCount) * head->blockSize ||
+        head->detailLength > static_cast<uint64_t>(head->detailBlockCount) * head->blockSize) {
+        return false;
+    }
+    const auto blockIndex = reinterpret_cast<const BlockRecord*>(base + head->texts);
+
+    // Decompress every text block straight into its final location in the buffer
+    QByteArray decompressed(static_cast<qsizetype>(head->textLength), Qt::Uninitialized);
+    char* destination = decompressed.data();
+    std::atomic<bool> success = true;
+    QList<uint32_t> blockIDs(head->blockCount);
+    std::iota(blockIDs.begin(), blockIDs.end(), 0);
+    QtConcurrent::blockingMap(blockIDs, [&](const uint32_t block) {
+        const BlockRecord& record = blockIndex[block];
+        const uint64_t offset = static_cast<uint64_t>(block) * head->blockSize;
+        const uint64_t expected =
+            std::min<uint64_t>(head->blockSize, head->textLength - std::min<uint64_t>(offset, head->textLength));
+        if (static_cast<uint64_t>(record.offset) + record.size > static_cast<uint64_t>(size)) {
+            success = false;
+            return;
+        }
+        const QByteArray data = qUncompress(base + record.offset, record.size);
+        if (static_cast<uint64_t>(data.size()) != expected) {
+            success = false;
+            return;
+        }
+        memcpy(destination + offset, data.constData(), expected);
+    });
+    if (!success) {
+        return false;
+    }
+
+    // The detail blocks are left compressed in the mapped file until they are needed
+    textBuffer = std::move(decompressed);
+    detailBlocks = blockIndex + head->blockCount;
+    return true;
+}
+
+QByteArray Dataset::getDetailBlock(const uint32_t block) const noexcept
+{
+    // Recently used blocks are kept in least to most recently used order
+    for (qsizetype i = detailCache.size() - 1; i >= 0; --i) {
+        if (detailCache[i].first == block) {
+            detailCache.move(i, detailCache.size() - 1);
+            return detailCache.last().second;
+        }
+    }
+    if (block >= header->detailBlockCount) {
+        return {};
+    }
+    const BlockRecord& record = detailBlocks[block];
+    if (static_cast<uint64_t>(record.offset) + record.size > static_cast<uint64_t>(size)) {
+        return {};
+    }
+    QByteArray data = qUncompress(base + record.offset, record.size);
+    if (detailCache.size() >= maxCachedDetailBlocks) {
+        detailCache.removeFirst();
+    }
+    detailCache.emplaceBack(block, data);
+    return data;
+}
+
+bool Dataset::validate() noexcept
+{
+    // All tables must be correctly aligned for the records to be read in place
+    if (reinterpret_cast<quintptr>(base) % alignof(Header) != 0) {
+        qWarning() << "Cached data is not correctly aligned";
+        return false;
+    }
+    header = reinterpret_cast<const Header*>(base);
+    if (header->fileID != fileID) {
+        qWarning() << "Cached data file had invalid identifier";
+        return false;
+    }
+    if (header->fileVersion != fileVersion) {
+        qInfo() << "Cached data version is to old, recreating from upstream sources";
+        return false;
+    }
+
+    // Check each table is within the data
+    const auto checkTable = [this](const uint32_t offset, const uint32_t count, const size_t recordSize) {
+        return offset % sizeof(uint32_t) == 0 && offset >= sizeof(Header) &&
+            static_cast<uint64_t>(offset) + static_cast<uint64_t>(count) * recordSize <= static_cast<uint64_t>(size);
+    };
+    if (!checkTable(header->instructions, header->instructionCount, sizeof(InstructionRecord)) ||
+        !checkTable(header->measurements, header->measurementCount, sizeof(MeasurementRecord)) ||
+        !checkTable(header->indices, header->indexCount, sizeof(uint32_t)) ||
+        !checkTable(header->stringRefs, header->stringRefCount, sizeof(StringRef)) ||
+        !checkTable(header->strings, header->stringLength, sizeof(char16_t))) {
+        qWarning() << "Cached data file is corrupt";
+        return false;
+    }
+    // The UTF-8 tables are either in the data or have been replaced by compressed blocks
+    const bool compressed = header->blockSize != 0;
+    const bool textsValid = compressed ?
+        detailBlocks != nullptr && textBuffer.size() == static_cast<qsizetype>(header->textLength) :
+        checkTable(header->texts, header->textLength, sizeof(char)) &&
+            checkTable(header->details, header->detailLength, sizeof(char));
+    if (!textsValid) {
+        qWarning() << "Cached data file is corrupt";
+        return false;
+    }
+    instructions = reinterpret_cast<const InstructionRecord*>(base + header->instructions);
+    measurements = reinterpret_cast<const MeasurementRecord*>(base + header->measurements);
+    indices = reinterpret_cast<const uint32_t*>(base + header->indices);
+    stringRefs = reinterpret_cast<const StringRef*>(base + header->stringRefs);
+    strings = reinterpret_cast<const char16_t*>(base + header->strings);
+    texts = compressed ? textBuffer.constData() : reinterpret_cast<const char*>(base + header->texts);
+    details = compressed ? nullptr : reinterpret_cast<const char*>(base + header->details);
+
+    // Check every reference so that the accessors never need to
+    const auto checkString = [this](const StringRef& string) {
+        return static_cast<uint64_t>(string.offset) + string.length <= header->stringLength;
+    };
+    const auto checkText = [this](const TextRef& text) {
+        return static_cast<uint64_t>(text.offset) + text.length <= header->textLength;
+    };
+    const auto checkDetail = [this](const TextRef& text) {
+        return static_cast<uint64_t>(text.offset) + text.length <= header->detailLength;
+    };
+    const auto checkRange = [](const RangeRef& range, const uint32_t count) {
+        return static_cast<uint64_t>(range.offset) + range.count <= count;
+    };
+    bool valid = checkString(header->version) && checkRange(header->technologies, header->stringRefCount) &&
+        checkRange(header->types, header->stringRefCount) && checkRange(header->categories, header->stringRefCount) &&
+        checkRange(header->validators, header->stringRefCount) &&
+        checkRange(header->architectures, header->stringRefCount) && checkRange(header->ports, header->stringRefCount);
+    for (uint32_t i = 0; valid && i < header->stringRefCount; ++i) {
+        valid = checkString(stringRefs[i]);
+    }
+    const uint32_t maxIndex = std::max(header->types.count, header->categories.count);
+    for (uint32_t i = 0; valid && i < header->indexCount; ++i) {
+        valid = indices[i] < maxIndex;
+    }
+    for (uint32_t i = 0; valid && i < header->measurementCount; ++i) {
+        valid = measurements[i].arch < header->architectures.count && measurements[i].ports < header->ports.count;
+    }
+    for (uint32_t i = 0; valid && i < header->instructionCount; ++i) {
+        const InstructionRecord& record = instructions[i];
+        valid = checkText(record.signature) && checkString(record.name) && checkDetail(record.description) &&
+            checkDetail(record.operation) && checkString(record.header) && checkString(record.cpuidText) &&
+            checkString(record.typeText) && checkString(record.categoryText) && checkString(record.instruction) &&
+            record.technology < header->technologies.count && checkRange(record.types, header->indexCount) &&
+            checkRange(record.categories, header->indexCount) &&
+            checkRange(record.measurements, header->measurementCount);
+    }
+    if (!valid) {
+        qWarning() << "Cached data file is corrupt";
+        return false;
+    }
+    return true;
+}
+
+QList<QString> Dataset::getStrings(const RangeRef& range) const noexcept
+{
+    QList<QString> ret;
+    ret.reserve(range.count);
+    for (uint32_t i = range.offset; i < range.offset + range.count; ++i) {
+        ret.emplaceBack(getString(stringRefs[i]).toString());
+    }
+    return ret;
+}
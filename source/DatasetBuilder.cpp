@@ -0,0 +1,58 @@
+/**
+ * Copyright Matthew Oliver
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "DataProvider.h"
+
+#include <QCoreApplication>
+
+/** Reports data provider status to the console */
+class BuilderHost final : public DataProviderHost
+{
+public:
+    void addOKDialog(const QString& title, const std::function<void()>& callback) override
+    {
+        qCritical().noquote() << title;
+        if (callback != nullptr) {
+            callback();
+        }
+    }
+
+    void setProgress(float /*newProgress*/) noexcept override {}
+
+    [[nodiscard]] bool getShutdown() const noexcept override
+    {
+        return false;
+    }
+
+    void setLoadingTitle(const QString& title) noexcept override
+    {
+        qInfo().noquote() << title;
+    }
+};
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+    const QStringList arguments = QCoreApplication::arguments();
+    if (arguments.size() != 4) {
+        qCritical() << "Usage: DatasetBuilder <intrinsics xml> <uops xml> <output file>";
+        return 1;
+    }
+
+    BuilderHost host;
+    DataProvider provider(&host);
+    return provider.build(arguments[1], arguments[2], arguments[3]) ? 0 : 1;
+}
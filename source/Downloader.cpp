@@ -19,71 +19,228 @@
 #include <QNetworkAccessManager>
 #include <QNetworkReply>
 #include <QNetworkRequest>
-#include <QtConcurrent>
 
-Downloader::Downloader(std::function<void(float)> setProgress) noexcept
+Downloader::Downloader(std::function<void(float)> setProgress, std::function<bool()> isCancelled) noexcept
     : QObject(nullptr)
     , callback(std::move(setProgress))
+    , cancelled(std::move(isCancelled))
 {
+    // A single manager is shared by all downloads so that connections can be reused
     manager = new QNetworkAccessManager(this);
-    connect(&timer, &QTimer::timeout, &loop, &QEventLoop::quit);
-    connect(manager, &QNetworkAccessManager::finished, &loop, &QEventLoop::quit);
+    // Periodically wake any wait so that cancellation is noticed even when no download makes progress
+    wakeTimer.setInterval(100);
+    connect(&wakeTimer, &QTimer::timeout, &loop, &QEventLoop::quit);
 }
 
 Downloader::~Downloader() noexcept
 {
+    abortAll();
     delete manager;
 }
 
-bool Downloader::get(const QUrl& url, QByteArray& retData) noexcept
+uint32_t Downloader::add(
+    const QUrl& url, const QString& fileName, const QByteArray& eTag, const QByteArray& lastModified) noexcept
 {
-    QNetworkRequest request(url);
-
-    request.setHeader(QNetworkRequest::ContentTypeHeader, "text/html; charset=UTF-8");
-    request.setHeader(QNetworkRequest::UserAgentHeader,
+    auto transfer = std::make_shared<Transfer>();
+    transfer->request.setUrl(url);
+    transfer->fileName = fileName;
+    transfer->request.setHeader(QNetworkRequest::ContentTypeHeader, "text/html; charset=UTF-8");
+    transfer->request.setHeader(QNetworkRequest::UserAgentHeader,
         "Mozilla/5.0 (Windows NT 10.0; Win64; x64; rv:65.0) Gecko/20100101 Firefox/65.0");
-    request.setRawHeader("Accept", "text/html,application/xhtml+xml,application/xml;q=0.9,image/webp,/;q=0.8");
-
-    uint32_t retries = 3;
-    bool fail = true;
-    while (retries != 0) {
-        QNetworkReply* reply = manager->get(request);
-        connect(reply, &QNetworkReply::downloadProgress, this, &Downloader::downloadProgress);
-        timer.start(10000); // 10000ms wait for reply
-        loop.exec();
+    transfer->request.setRawHeader(
+        "Accept", "text/html,application/xhtml+xml,application/xml;q=0.9,image/webp,/;q=0.8");
+    // Only request the data if it differs from what the caller already has
+    if (!eTag.isEmpty()) {
+        transfer->request.setRawHeader("If-None-Match", eTag);
+    }
+    if (!lastModified.isEmpty()) {
+        transfer->request.setRawHeader("If-Modified-Since", lastModified);
+    }
+    transfer->timer.setSingleShot(true);
+    connect(&transfer->timer, &QTimer::timeout, this, [transfer = transfer.get()] {
+        // Abort stalled replies, this results in the finished signal being raised with an error
+        if (transfer->reply != nullptr) {
+            qCritical() << "Failed to download file: timed out";
+            transfer->reply->abort();
+        }
+    });
+    transfers.emplaceBack(transfer);
+    start(*transfer);
+    return static_cast<uint32_t>(transfers.size() - 1);
+}
 
-        if (nullptr == reply) {
-            // Error. we probably timed out i.e SIGNAL(finished()) did not happen
-            // this handles above indicated case (1)
-            qCritical() << "Failed to download file: internal error";
-        } else if (QNetworkReply::NoError != reply->error()) {
-            qCritical() << "Failed to download file: " << reply->errorString();
-            delete reply;
-        } else {
-            retData = reply->readAll();
-            delete reply;
-            fail = false;
+bool Downloader::wait(const uint32_t id) noexcept
+{
+    if (id >= static_cast<uint32_t>(transfers.size())) {
+        return false;
+    }
+    const auto transfer = transfers[id];
+    if (cancelled != nullptr) {
+        wakeTimer.start();
+    }
+    // Any finished download wakes the loop so keep waiting until the requested one is done
+    while (!transfer->finished) {
+        if (cancelled != nullptr && cancelled()) {
+            abortAll();
             break;
         }
-        --retries;
-        if (retries > 0) {
-            qCritical() << "Attempting to download file again";
+        loop.exec();
+    }
+    wakeTimer.stop();
+    return transfer->success;
+}
+
+bool Downloader::wait(const uint32_t id, QByteArray& retData) noexcept
+{
+    if (!wait(id)) {
+        return false;
+    }
+    retData = std::move(transfers[id]->data);
+    transfers[id]->data.clear();
+    return true;
+}
+
+bool Downloader::isNotModified(const uint32_t id) const noexcept
+{
+    return id < static_cast<uint32_t>(transfers.size()) && transfers[id]->notModified;
+}
+
+QByteArray Downloader::getETag(const uint32_t id) const noexcept
+{
+    return id < static_cast<uint32_t>(transfers.size()) ? transfers[id]->eTag : QByteArray();
+}
+
+QByteArray Downloader::getLastModified(const uint32_t id) const noexcept
+{
+    return id < static_cast<uint32_t>(transfers.size()) ? transfers[id]->lastModified : QByteArray();
+}
+
+bool Downloader::get(const QUrl& url, QByteArray& retData) noexcept
+{
+    return wait(add(url), retData);
+}
+
+void Downloader::abortAll() noexcept
+{
+    for (auto& transfer : transfers) {
+        transfer->timer.stop();
+        if (transfer->reply != nullptr) {
+            // Disconnect first so that aborting does not trigger another attempt
+            disconnect(transfer->reply, nullptr, this, nullptr);
+            transfer->reply->abort();
+            delete transfer->reply;
+            transfer->reply = nullptr;
+        }
+        // Any partially written file is discarded without replacing the existing one
+        transfer->file = nullptr;
+        transfer->finished = true;
+    }
+}
+
+void Downloader::start(Transfer& transfer) noexcept
+{
+    transfer.received = 0;
+    transfer.total = 0;
+    transfer.data.clear();
+    if (!transfer.fileName.isEmpty()) {
+        // Each attempt starts a new file so that a failed attempt never leaves partial data behind
+        transfer.file = std::make_unique<QSaveFile>(transfer.fileName);
+        if (!transfer.file->open(QIODevice::WriteOnly)) {
+            qCritical() << "Failed to open file for writing: " << transfer.fileName;
+            transfer.file = nullptr;
+            transfer.finished = true;
+            loop.quit();
+            return;
+        }
+    }
+    transfer.reply = manager->get(transfer.request);
+    connect(transfer.reply, &QNetworkReply::readyRead, this, [this, &transfer] { readyRead(transfer); });
+    connect(transfer.reply, &QNetworkReply::downloadProgress, this,
+        [this, &transfer](const qint64 bytesReceived, const qint64 bytesTotal) {
+            downloadProgress(transfer, bytesReceived, bytesTotal);
+        });
+    connect(transfer.reply, &QNetworkReply::finished, this, [this, &transfer] { finished(transfer); });
+    transfer.timer.start(10000); // 10000ms wait for reply
+}
+
+void Downloader::readyRead(Transfer& transfer) noexcept
+{
+    // Data is passed straight through to the file so the full reply is never held in memory
+    if (transfer.file != nullptr && transfer.reply != nullptr) {
+        const QByteArray chunk = transfer.reply->readAll();
+        if (transfer.file->write(chunk) != chunk.size()) {
+            qCritical() << "Failed to write file: " << transfer.fileName;
+            transfer.retries = 1;
+            transfer.reply->abort();
         }
     }
+}
 
+void Downloader::finished(Transfer& transfer) noexcept
+{
+    transfer.timer.stop();
+    readyRead(transfer);
+    QNetworkReply* reply = transfer.reply;
+    transfer.reply = nullptr;
+    if (QNetworkReply::NoError != reply->error()) {
+        qCritical() << "Failed to download file: " << reply->errorString();
+        reply->deleteLater();
+        transfer.file = nullptr;
+        --transfer.retries;
+        if (transfer.retries > 0) {
+            qCritical() << "Attempting to download file again";
+            start(transfer);
+            return;
+        }
+    } else {
+        // Keep the validators so that later requests can check whether the resource has changed
+        transfer.eTag = reply->rawHeader("ETag");
+        transfer.lastModified = reply->rawHeader("Last-Modified");
+        if (reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() == 304) {
+            // The existing data is still current so discard the (empty) reply without touching any file
+            transfer.notModified = true;
+            transfer.success = true;
+            transfer.file = nullptr;
+        } else if (transfer.file != nullptr) {
+            transfer.success = transfer.file->commit();
+            if (!transfer.success) {
+                qCritical() << "Failed to write file: " << transfer.fileName;
+            }
+            transfer.file = nullptr;
+        } else {
+            transfer.data = reply->readAll();
+            transfer.success = true;
+        }
+        reply->deleteLater();
+    }
+    transfer.finished = true;
+    transfer.received = std::max(transfer.total, transfer.received);
+    transfer.total = transfer.received;
     if (callback != nullptr) {
-        callback(1.0f);
+        downloadProgress(transfer, transfer.received, transfer.total);
     }
-    return !fail;
+    loop.quit();
 }
 
-void Downloader::downloadProgress(const qint64 bytesReceived, const qint64 bytesTotal)
+void Downloader::downloadProgress(Transfer& transfer, const qint64 bytesReceived, const qint64 bytesTotal)
 {
     // Reset timer when progress is detected
-    timer.start(10000);
+    if (!transfer.finished) {
+        transfer.timer.start(10000);
+    }
+    transfer.received = bytesReceived;
+    transfer.total = bytesTotal;
 
     if (callback != nullptr) {
-        const float progress = static_cast<float>(bytesReceived) / static_cast<float>(bytesTotal);
-        callback(progress);
+        // Report the average progress of all downloads, those with an unknown size count as not started
+        float progress = 0.0F;
+        for (const auto& i : transfers) {
+            if (i->finished) {
+                progress += 1.0F;
+            } else if (i->total > 0) {
+                progress += static_cast<float>(i->received) / static_cast<float>(i->total);
+            }
+        }
+        callback(progress / static_cast<float>(transfers.size()));
     }
 }
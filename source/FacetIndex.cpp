@@ -0,0 +1,90 @@
+/**
+ * Copyright Matthew Oliver
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "FacetIndex.h"
+
+#include <QtAlgorithms>
+
+FacetIndex::FacetIndex(const Dataset& data) noexcept
+    : words((static_cast<qsizetype>(data.getInstructionCount()) + 63) / 64)
+{
+    auto& technologies = sets[static_cast<size_t>(Facet::Technology)];
+    auto& types = sets[static_cast<size_t>(Facet::Type)];
+    auto& categories = sets[static_cast<size_t>(Facet::Category)];
+    technologies.resize(data.getTechnologies().size(), createSet(false));
+    types.resize(data.getTypes().size(), createSet(false));
+    categories.resize(data.getCategories().size(), createSet(false));
+
+    const auto add = [&data](QList<RowSet>& facet, const Dataset::RangeRef& range, const uint32_t row) {
+        for (uint32_t i = range.offset; i < range.offset + range.count; ++i) {
+            if (const auto index = data.getIndex(i); index < facet.size()) {
+                facet[index][row / 64] |= 1ULL << (row % 64);
+            }
+        }
+    };
+    for (uint32_t i = 0; i < data.getInstructionCount(); ++i) {
+        const auto& instruction = data.getInstruction(i);
+        if (instruction.technology < technologies.size()) {
+            technologies[instruction.technology][i / 64] |= 1ULL << (i % 64);
+        }
+        add(types, instruction.types, i);
+        add(categories, instruction.categories, i);
+    }
+}
+
+RowSet FacetIndex::createSet(const bool all) const noexcept
+{
+    return RowSet(words, all ? ~0ULL : 0ULL);
+}
+
+RowSet FacetIndex::getMatches(const Facet facet, const FilterMask& checked) const noexcept
+{
+    if (checked.none()) {
+        return createSet(true);
+    }
+    RowSet ret = createSet(false);
+    const auto& options = sets[static_cast<size_t>(facet)];
+    for (qsizetype i = 0; i < std::min(options.size(), static_cast<qsizetype>(checked.size())); ++i) {
+        if (checked.test(static_cast<size_t>(i))) {
+            for (qsizetype j = 0; j < words; ++j) {
+                ret[j] |= options[i][j];
+            }
+        }
+    }
+    return ret;
+}
+
+QList<uint32_t> FacetIndex::getCounts(const Facet facet, const RowSet& rows) const noexcept
+{
+    const auto& options = sets[static_cast<size_t>(facet)];
+    QList<uint32_t> ret;
+    ret.reserve(options.size());
+    for (const auto& option : options) {
+        uint32_t count = 0;
+        for (qsizetype j = 0; j < std::min(words, rows.size()); ++j) {
+            count += qPopulationCount(static_cast<quint64>(option[j] & rows[j]));
+        }
+        ret.emplaceBack(count);
+    }
+    return ret;
+}
+
+void FacetIndex::intersect(RowSet& rows, const RowSet& other) noexcept
+{
+    for (qsizetype i = 0; i < std::min(rows.size(), other.size()); ++i) {
+        rows[i] &= other[i];
+    }
+}
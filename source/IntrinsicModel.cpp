@@ -19,47 +19,72 @@
 #include "Application.h"
 #include "MeasurementModel.h"
 
+#include <QSet>
+
 IntrinsicModel::IntrinsicModel(QObject* parent) noexcept
     : QAbstractListModel(parent)
 {}
 
 int IntrinsicModel::rowCount(const QModelIndex& /*parameter1*/) const noexcept
 {
-    return static_cast<int>(instructions.count());
+    return static_cast<int>(expanded.count());
 }
 
 QVariant IntrinsicModel::data(const QModelIndex& index, const int role) const noexcept
 {
-    if (index.row() >= 0 && index.row() < instructions.count()) {
+    if (index.row() >= 0 && index.row() < expanded.count()) {
+        const auto& instruction = dataset->getInstruction(static_cast<uint32_t>(index.row()));
+        const auto getIndices = [this](const Dataset::RangeRef& range) {
+            QList<uint32_t> ret;
+            ret.reserve(range.count);
+            for (uint32_t i = range.offset; i < range.offset + range.count; ++i) {
+                ret.emplaceBack(dataset->getIndex(i));
+            }
+            return ret;
+        };
         switch (role) {
             case IntrinsicRoleFullName:
-                return instructions.at(index.row()).fullName;
+                return formatter.formatSignature(static_cast<uint32_t>(index.row()),
+                    dataset->getString(instruction.name), dataset->getText(instruction.signature));
             case IntrinsicRoleName:
-                return instructions.at(index.row()).name;
+                return dataset->getString(instruction.name).toString();
             case IntrinsicRoleDescription:
-                return instructions.at(index.row()).description;
+                return formatter.formatDescription(static_cast<uint32_t>(index.row()),
+                    dataset->getText(instruction.signature), dataset->getDetail(instruction.description));
             case IntrinsicRoleOperation:
-                return instructions.at(index.row()).operation;
+                return dataset->getDetail(instruction.operation);
             case IntrinsicRoleHeader:
-                return instructions.at(index.row()).header;
+                return dataset->getString(instruction.header).toString();
             case IntrinsicRoleCPUIDText:
-                return instructions.at(index.row()).cpuidText;
+                return dataset->getString(instruction.cpuidText).toString();
             case IntrinsicRoleTypesText:
-                return instructions.at(index.row()).typeText;
+                return dataset->getString(instruction.typeText).toString();
             case IntrinsicRoleCategoriesText:
-                return instructions.at(index.row()).categoryText;
+                return dataset->getString(instruction.categoryText).toString();
             case IntrinsicRoleTechnology:
-                return instructions.at(index.row()).technology;
+                return instruction.technology;
             case IntrinsicRoleTypes:
-                return QVariant::fromValue(instructions.at(index.row()).types);
+                return QVariant::fromValue(getIndices(instruction.types));
             case IntrinsicRoleCategories:
-                return QVariant::fromValue(instructions.at(index.row()).categories);
+                return QVariant::fromValue(getIndices(instruction.categories));
             case IntrinsicRoleInstruction:
-                return instructions.at(index.row()).instruction;
-            case IntrinsicRoleMeasurements:
-                return QVariant::fromValue(static_cast<QObject*>(instructions.at(index.row()).measurements.get()));
+                return dataset->getString(instruction.instruction).toString();
+            case IntrinsicRoleMeasurements: {
+                // Measurement models are only created once they are actually displayed, reusing any released ones
+                auto& measurement = measurements[index.row()];
+                if (measurement == nullptr) {
+                    if (!measurementPool.isEmpty()) {
+                        measurement = measurementPool.takeLast();
+                        measurement->setInstruction(dataset, static_cast<uint32_t>(index.row()));
+                    } else {
+                        measurement = std::make_shared<MeasurementModel>(dataset, static_cast<uint32_t>(index.row()),
+                            reinterpret_cast<QObject*>(const_cast<IntrinsicModel*>(this)));
+                    }
+                }
+                return QVariant::fromValue(static_cast<QObject*>(measurement.get()));
+            }
             case IntrinsicRoleExpanded:
-                return instructions.at(index.row()).expanded;
+                return expanded.at(index.row());
             default:
                 break;
         }
@@ -87,10 +112,14 @@ Qt::ItemFlags IntrinsicModel::flags(const QModelIndex& /*index*/) const noexcept
 
 bool IntrinsicModel::setData(const QModelIndex& index, const QVariant& value, const int role) noexcept
 {
-    if (index.row() < instructions.count()) {
+    if (index.row() < expanded.count()) {
         if (role == IntrinsicRoleExpanded) {
             // Update the value
-            instructions[index.row()].expanded = value.toBool();
+            expanded[index.row()] = value.toBool();
+            if (!expanded[index.row()]) {
+                // The measurements are no longer displayed once collapsed
+                releaseMeasurements(index.row());
+            }
             emit dataChanged(index, index, {role});
             return true;
         }
@@ -101,33 +130,133 @@ bool IntrinsicModel::setData(const QModelIndex& index, const QVariant& value, co
     return false;
 }
 
-void IntrinsicModel::load(QList<InstructionIndexed>& data) noexcept
+void IntrinsicModel::setSignatureColours(const QString& type, const QString& name) noexcept
+{
+    formatter.setColours(type, name);
+    if (!expanded.isEmpty()) {
+        emit dataChanged(index(0), index(static_cast<int>(expanded.count()) - 1),
+            {IntrinsicRoleFullName, IntrinsicRoleDescription});
+    }
+}
+
+void IntrinsicModel::load(const std::shared_ptr<Dataset>& data) noexcept
 {
-    if (!instructions.isEmpty()) {
+    formatter.clear();
+    if (!expanded.isEmpty()) {
         emit beginResetModel();
-        instructions.clear();
+        measurements.clear();
+        expanded.clear();
+        typeMasks.clear();
+        categoryMasks.clear();
+        dataset = nullptr;
         emit endResetModel();
     }
-    emit beginInsertRows(QModelIndex(), 0, static_cast<int>(data.count()) - 1);
-    // Move in data
-    for (auto& i : data) {
-        instructions.emplaceBack(std::move(i), reinterpret_cast<QObject*>(this));
+    const auto count = static_cast<qsizetype>(data->getInstructionCount());
+    emit beginInsertRows(QModelIndex(), 0, static_cast<int>(count) - 1);
+    // The data is read in place so only the per row state needs to be allocated
+    dataset = data;
+    expanded.resize(count, false);
+    typeMasks.resize(count);
+    categoryMasks.resize(count);
+    for (qsizetype i = 0; i < count; ++i) {
+        updateMasks(i);
     }
     emit endInsertRows();
 }
 
-InstructionModeled::InstructionModeled(InstructionIndexed&& base, QObject* parent)
-    : fullName(std::forward<QString>(base.fullName))
-    , name(std::forward<QString>(base.name))
-    , description(std::forward<QString>(base.description))
-    , operation(std::forward<QString>(base.operation))
-    , header(std::forward<QString>(base.header))
-    , cpuidText(std::forward<QString>(base.cpuidText))
-    , typeText(std::forward<QString>(base.typeText))
-    , categoryText(std::forward<QString>(base.categoryText))
-    , technology(base.technology)
-    , types(std::forward<QList<uint32_t>>(base.types))
-    , categories(std::forward<QList<uint32_t>>(base.categories))
-    , instruction(std::forward<QString>(base.instruction))
-    , measurements(std::make_shared<MeasurementModel>(std::forward<QList<Measurements>>(base.measurements), parent))
-{}
+void IntrinsicModel::update(const std::shared_ptr<Dataset>& data) noexcept
+{
+    // Intrinsics are matched by name as their positions may differ in the new data
+    QSet<QString> expandedNames;
+    for (qsizetype i = 0; i < expanded.count(); ++i) {
+        if (expanded[i]) {
+            expandedNames.insert(dataset->getString(dataset->getInstruction(static_cast<uint32_t>(i)).name).toString());
+        }
+    }
+    const auto oldCount = expanded.count();
+    const auto count = static_cast<qsizetype>(data->getInstructionCount());
+    if (count < oldCount) {
+        beginRemoveRows(QModelIndex(), static_cast<int>(count), static_cast<int>(oldCount) - 1);
+        for (qsizetype i = count; i < oldCount; ++i) {
+            releaseMeasurements(i);
+        }
+        expanded.resize(count);
+        typeMasks.resize(count);
+        categoryMasks.resize(count);
+        endRemoveRows();
+    }
+
+    // Swap in the new data for all existing rows
+    dataset = data;
+    formatter.clear();
+    const auto existing = std::min(count, oldCount);
+    for (qsizetype i = 0; i < existing; ++i) {
+        expanded[i] = expandedNames.contains(
+            dataset->getString(dataset->getInstruction(static_cast<uint32_t>(i)).name).toString());
+        updateMasks(i);
+        // Displayed measurement models are updated in place so that they remain valid for the views
+        if (const auto measurement = measurements.find(i); measurement != measurements.end()) {
+            if (expanded[i]) {
+                measurement.value()->setInstruction(dataset, static_cast<uint32_t>(i));
+            } else {
+                releaseMeasurements(i);
+            }
+        }
+    }
+
+    if (count > oldCount) {
+        beginInsertRows(QModelIndex(), static_cast<int>(oldCount), static_cast<int>(count) - 1);
+        expanded.resize(count, false);
+        typeMasks.resize(count);
+        categoryMasks.resize(count);
+        for (qsizetype i = oldCount; i < count; ++i) {
+            expanded[i] = expandedNames.contains(
+                dataset->getString(dataset->getInstruction(static_cast<uint32_t>(i)).name).toString());
+            updateMasks(i);
+        }
+        endInsertRows();
+    }
+    if (existing > 0) {
+        emit dataChanged(index(0), index(static_cast<int>(existing) - 1));
+    }
+}
+
+uint32_t IntrinsicModel::getTechnology(const qsizetype row) const noexcept
+{
+    return dataset->getInstruction(static_cast<uint32_t>(row)).technology;
+}
+
+const FilterMask& IntrinsicModel::getTypeMask(const qsizetype row) const noexcept
+{
+    return typeMasks[row];
+}
+
+const FilterMask& IntrinsicModel::getCategoryMask(const qsizetype row) const noexcept
+{
+    return categoryMasks[row];
+}
+
+void IntrinsicModel::releaseMeasurements(const qsizetype row) noexcept
+{
+    // Only a few models are kept as only a handful of intrinsics are ever expanded at once
+    constexpr qsizetype maxPooled = 8;
+    if (auto measurement = measurements.take(row); measurement != nullptr && measurementPool.size() < maxPooled) {
+        measurementPool.emplaceBack(std::move(measurement));
+    }
+}
+
+void IntrinsicModel::updateMasks(const qsizetype row) noexcept
+{
+    const auto getMask = [this](const Dataset::RangeRef& range) {
+        FilterMask mask;
+        for (uint32_t i = range.offset; i < range.offset + range.count; ++i) {
+            if (const auto index = dataset->getIndex(i); index < mask.size()) {
+                mask.set(index);
+            }
+        }
+        return mask;
+    };
+    const auto& instruction = dataset->getInstruction(static_cast<uint32_t>(row));
+    typeMasks[row] = getMask(instruction.types);
+    categoryMasks[row] = getMask(instruction.categories);
+}
@@ -18,14 +18,25 @@
 
 #include "Application.h"
 
+#include <QtConcurrent>
+
+#include <cmath>
+#include <limits>
+
 IntrinsicProxyModel::IntrinsicProxyModel(QObject* parent)
     : QSortFilterProxyModel(parent)
-{}
+{
+    // Searches are only started once typing has paused for a short time
+    searchTimer.setSingleShot(true);
+    searchTimer.setInterval(100);
+    connect(&searchTimer, &QTimer::timeout, this, &IntrinsicProxyModel::startSearch);
+    connect(&searchWatcher, &QFutureWatcher<QList<uint32_t>>::finished, this, &IntrinsicProxyModel::finishSearch);
+}
 
 bool IntrinsicProxyModel::filterAcceptsRow(const int sourceRow, const QModelIndex& sourceParent) const
 {
     // Check if model has been initialised
-    if (allTechnologies == nullptr) {
+    if (checkedTechnologies == nullptr) {
         return false;
     }
 
@@ -35,40 +46,27 @@ bool IntrinsicProxyModel::filterAcceptsRow(const int sourceRow, const QModelInde
         return false;
     }
 
-    if (!noTechChecked &&
-        !(*allTechnologies)[static_cast<qsizetype>(
-                                sourceModel()->data(index, IntrinsicModel::IntrinsicRoleTechnology).toUInt())]
-             .checked) {
-        return false;
-    }
-    bool valType = noTypeChecked;
-    if (!valType) {
-        for (const auto& j : sourceModel()->data(index, IntrinsicModel::IntrinsicRoleTypes).toList()) {
-            valType = (*allTypes)[static_cast<qsizetype>(j.toUInt())].checked;
-            if (valType) {
-                break;
-            }
+    // The filters are checked directly against the precomputed masks of the intrinsic
+    const auto* intrinsics = static_cast<const IntrinsicModel*>(sourceModel());
+    if (!noTechChecked) {
+        if (const auto technology = intrinsics->getTechnology(sourceRow);
+            technology >= checkedTechnologies->size() || !checkedTechnologies->test(technology)) {
+            return false;
         }
     }
-    if (!valType) {
+    if (!noTypeChecked && (intrinsics->getTypeMask(sourceRow) & *checkedTypes).none()) {
         return false;
     }
-    bool valCat = noCatsChecked;
-    if (!valCat) {
-        for (const auto& j : sourceModel()->data(index, IntrinsicModel::IntrinsicRoleCategories).toList()) {
-            valCat = (*allCategories)[static_cast<qsizetype>(j.toUInt())].checked;
-            if (valCat) {
-                break;
-            }
-        }
+    if (!noCatsChecked && (intrinsics->getCategoryMask(sourceRow) & *checkedCategories).none()) {
+        return false;
     }
-    if (!valCat) {
+    if (measuredColumn != nullptr &&
+        (sourceRow >= performanceIndex->getCount() || std::isnan(measuredColumn[sourceRow]))) {
         return false;
     }
 
     // Check the search string
-    if (!search.isEmpty() &&
-        !sourceModel()->data(index, IntrinsicModel::IntrinsicRoleName).toString().contains(search)) {
+    if (!search.isEmpty() && (sourceRow >= searchMatches.size() || !searchMatches[sourceRow])) {
         return false;
     }
     return true;
@@ -76,6 +74,25 @@ bool IntrinsicProxyModel::filterAcceptsRow(const int sourceRow, const QModelInde
 
 bool IntrinsicProxyModel::lessThan(const QModelIndex& left, const QModelIndex& right) const
 {
+    if (sortColumn != nullptr) {
+        // Intrinsics without a known value are always placed last, otherwise the source order (by name) is kept. Rows
+        // outside the performance index (e.g. while the source model is being replaced) are treated as unknown.
+        const qsizetype count = performanceIndex->getCount();
+        const float leftValue =
+            left.row() < count ? sortColumn[left.row()] : std::numeric_limits<float>::quiet_NaN();
+        const float rightValue =
+            right.row() < count ? sortColumn[right.row()] : std::numeric_limits<float>::quiet_NaN();
+        const bool leftUnknown = std::isnan(leftValue);
+        const bool rightUnknown = std::isnan(rightValue);
+        if (leftUnknown != rightUnknown) {
+            return rightUnknown;
+        }
+        if (!leftUnknown && leftValue != rightValue) {
+            return leftValue < rightValue;
+        }
+        return left.row() < right.row();
+    }
+
     const QVariant leftData = sourceModel()->data(left);
     const QVariant rightData = sourceModel()->data(right);
 
@@ -85,48 +102,244 @@ bool IntrinsicProxyModel::lessThan(const QModelIndex& left, const QModelIndex& r
     return false;
 }
 
-void IntrinsicProxyModel::load(const QList<StringChecked>& technologies, const QList<StringChecked>& types,
-    const QList<StringChecked>& categories) noexcept
+void IntrinsicProxyModel::load(
+    const FilterMask& technologies, const FilterMask& types, const FilterMask& categories) noexcept
 {
     // Copy in data
     beginResetModel();
-    allTechnologies = &technologies;
-    allTypes = &types;
-    allCategories = &categories;
+    checkedTechnologies = &technologies;
+    checkedTypes = &types;
+    checkedCategories = &categories;
     endResetModel();
 }
 
 void IntrinsicProxyModel::filterUpdated()
 {
-    beginResetModel();
+    // Changes made within the same event loop iteration are combined into a single update
+    if (filterPending) {
+        return;
+    }
+    filterPending = true;
+    QTimer::singleShot(0, this, &IntrinsicProxyModel::applyFilter);
+}
+
+void IntrinsicProxyModel::applyFilter() noexcept
+{
+    // Only the rows that change are inserted/removed so that the view keeps its position and delegates
+    filterPending = false;
+    checkedUpdated();
+    invalidateRowsFilter();
+    updateFacetCounts();
+}
+
+void IntrinsicProxyModel::checkedUpdated() noexcept
+{
     // Check if any options are checked at all and cache the result for faster searching
-    noTechChecked = true;
-    for (const auto& i : *allTechnologies) {
-        if (i.checked) {
-            noTechChecked = false;
-            break;
+    noTechChecked = checkedTechnologies->none();
+    noTypeChecked = checkedTypes->none();
+    noCatsChecked = checkedCategories->none();
+}
+
+void IntrinsicProxyModel::setFilterExpression(const QString& filter)
+{
+    // Any previously requested search that has not yet been applied is now out of date
+    pendingSearch = filter.trimmed();
+    cancelSearch();
+    searchTimer.start();
+}
+
+void IntrinsicProxyModel::setSearchIndex(
+    const std::shared_ptr<SearchIndex>& index, std::function<void()> apply) noexcept
+{
+    // Any running search is using the old index so its result is discarded
+    if (searchWatcher.isRunning()) {
+        cancelSearch();
+    }
+    if (search.isEmpty()) {
+        // Nothing is filtered by the search so the new data can be used straight away
+        pendingIndex = nullptr;
+        pendingApply = nullptr;
+        searchIndex = index;
+        if (apply) {
+            apply();
         }
+        return;
+    }
+    // The current data and matches are kept until the search has been repeated in the background against the new index
+    pendingIndex = index;
+    pendingApply = std::move(apply);
+    cancelSearch();
+    if (!searchTimer.isActive()) {
+        startSearch();
+    }
+}
+
+void IntrinsicProxyModel::setPerformanceIndex(const std::shared_ptr<PerformanceIndex>& index) noexcept
+{
+    // Keep the same architecture selected if it still exists
+    performanceIndex = index;
+    updateColumns();
+    emit architecturesChanged();
+}
+
+void IntrinsicProxyModel::setFacetIndex(const std::shared_ptr<FacetIndex>& index) noexcept
+{
+    facetIndex = index;
+}
+
+void IntrinsicProxyModel::updateFacetCounts() noexcept
+{
+    if (facetIndex == nullptr || checkedTechnologies == nullptr) {
+        return;
+    }
+    // The rows passing the search and architecture filters are shared by all groups
+    RowSet base = facetIndex->createSet(true);
+    if (!search.isEmpty()) {
+        FacetIndex::intersect(base, searchRows);
     }
-    noTypeChecked = true;
-    for (const auto& i : *allTypes) {
-        if (i.checked) {
-            noTypeChecked = false;
-            break;
+    if (measuredColumn != nullptr) {
+        FacetIndex::intersect(base, measuredRows);
+    }
+    const RowSet technologies = facetIndex->getMatches(FacetIndex::Facet::Technology, *checkedTechnologies);
+    const RowSet types = facetIndex->getMatches(FacetIndex::Facet::Type, *checkedTypes);
+    const RowSet categories = facetIndex->getMatches(FacetIndex::Facet::Category, *checkedCategories);
+
+    // Each group is counted without its own filter so that checking further options in it is shown as adding rows
+    RowSet rows = base;
+    FacetIndex::intersect(rows, types);
+    FacetIndex::intersect(rows, categories);
+    const QList<uint32_t> technologyCounts = facetIndex->getCounts(FacetIndex::Facet::Technology, rows);
+    rows = base;
+    FacetIndex::intersect(rows, technologies);
+    FacetIndex::intersect(rows, categories);
+    const QList<uint32_t> typeCounts = facetIndex->getCounts(FacetIndex::Facet::Type, rows);
+    rows = std::move(base);
+    FacetIndex::intersect(rows, technologies);
+    FacetIndex::intersect(rows, types);
+    const QList<uint32_t> categoryCounts = facetIndex->getCounts(FacetIndex::Facet::Category, rows);
+    emit facetCountsChanged(technologyCounts, typeCounts, categoryCounts);
+}
+
+QList<QString> IntrinsicProxyModel::getArchitectures() const noexcept
+{
+    return performanceIndex != nullptr ? performanceIndex->getArchitectures() : QList<QString>();
+}
+
+int IntrinsicProxyModel::getArchitecture() const noexcept
+{
+    return static_cast<int>(archIndex);
+}
+
+void IntrinsicProxyModel::setArchitecture(const int arch) noexcept
+{
+    const QList<QString> architectures = getArchitectures();
+    architecture = arch >= 0 && arch < architectures.size() ? architectures[arch] : QString();
+    updateColumns();
+    emit architecturesChanged();
+    // Both the filtered rows and their order depend on the architecture
+    invalidateRowsFilter();
+    sort(sortColumn != nullptr ? 0 : -1);
+    updateFacetCounts();
+}
+
+void IntrinsicProxyModel::setSortMetric(const int metric) noexcept
+{
+    sortMetric = metric >= 0 && metric < static_cast<int>(PerformanceIndex::Metric::Count) ? metric : -1;
+    updateColumns();
+    // The source is already in name order so sorting is disabled when sorting by name
+    sort(sortColumn != nullptr ? 0 : -1);
+}
+
+void IntrinsicProxyModel::updateColumns() noexcept
+{
+    archIndex = performanceIndex != nullptr ? performanceIndex->getArchitectures().indexOf(architecture) : -1;
+    measuredRows.clear();
+    if (archIndex < 0) {
+        sortColumn = nullptr;
+        measuredColumn = nullptr;
+        return;
+    }
+    // Every measurement has a uops value so it is only unknown for intrinsics without a measurement
+    measuredColumn = performanceIndex->getColumn(archIndex, PerformanceIndex::Metric::Uops);
+    measuredRows.resize((performanceIndex->getCount() + 63) / 64, 0);
+    for (qsizetype i = 0; i < performanceIndex->getCount(); ++i) {
+        if (!std::isnan(measuredColumn[i])) {
+            measuredRows[i / 64] |= 1ULL << (i % 64);
         }
     }
-    noCatsChecked = true;
-    for (const auto& i : *allCategories) {
-        if (i.checked) {
-            noCatsChecked = false;
-            break;
+    sortColumn = sortMetric >= 0 ?
+        performanceIndex->getColumn(archIndex, static_cast<PerformanceIndex::Metric>(sortMetric)) :
+        nullptr;
+}
+
+void IntrinsicProxyModel::cancelSearch() noexcept
+{
+    ++searchGeneration;
+    if (searchCancelled != nullptr) {
+        *searchCancelled = true;
+    }
+}
+
+void IntrinsicProxyModel::startSearch() noexcept
+{
+    // Only a single search runs at a time, once the current one finishes the latest search is started
+    if (searchWatcher.isRunning()) {
+        return;
+    }
+    runningGeneration = searchGeneration;
+    runningSearch = pendingSearch;
+    // The search runs against its own reference to the index so that it is unaffected by any data updates. Any new
+    // index is searched so that its data can be applied once the search completes.
+    const std::shared_ptr<SearchIndex> index = pendingIndex != nullptr ? pendingIndex : searchIndex;
+    // Each search has its own flag so that cancelling an old search can never stop a newer one
+    searchCancelled = std::make_shared<std::atomic_bool>(false);
+    searchWatcher.setFuture(QtConcurrent::run([index, query = runningSearch, cancelled = searchCancelled] {
+        return query.isEmpty() || index == nullptr ? QList<uint32_t>() : index->find(query, cancelled.get());
+    }));
+}
+
+void IntrinsicProxyModel::finishSearch() noexcept
+{
+    if (runningGeneration != searchGeneration) {
+        // The search has changed since this one was started, the latest is started once typing pauses
+        if (!searchTimer.isActive()) {
+            startSearch();
         }
+        return;
     }
-    endResetModel();
+    const bool newIndex = pendingIndex != nullptr;
+    if (runningSearch == search && !newIndex) {
+        return;
+    }
+    search = runningSearch;
+    if (newIndex) {
+        searchIndex = std::move(pendingIndex);
+    }
+    updateMatches(searchWatcher.result());
+    if (newIndex) {
+        // The matches are updated first so that the new data is only ever filtered using its own matches
+        const std::function<void()> apply = std::move(pendingApply);
+        pendingApply = nullptr;
+        if (apply) {
+            apply();
+        }
+    }
+    invalidateRowsFilter();
+    updateFacetCounts();
 }
 
-void IntrinsicProxyModel::setFilterExpression(const QString& filter)
+void IntrinsicProxyModel::updateMatches(const QList<uint32_t>& rows) noexcept
 {
-    beginResetModel();
-    search = filter.trimmed();
-    endResetModel();
+    searchMatches.clear();
+    searchRows.clear();
+    if (search.isEmpty() || searchIndex == nullptr) {
+        return;
+    }
+    // The index only returns the matching rows so they are expanded out for direct lookup when filtering
+    searchMatches.resize(searchIndex->getCount(), false);
+    searchRows.resize((searchIndex->getCount() + 63) / 64, 0);
+    for (const auto i : rows) {
+        searchMatches[i] = true;
+        searchRows[i / 64] |= 1ULL << (i % 64);
+    }
 }
@@ -22,14 +22,23 @@ MeasurementModel::MeasurementModel(QObject* parent) noexcept
     : QAbstractTableModel(parent)
 {}
 
-MeasurementModel::MeasurementModel(QList<Measurements>&& data, QObject* parent) noexcept
+MeasurementModel::MeasurementModel(std::shared_ptr<Dataset> data, const uint32_t instruction, QObject* parent) noexcept
     : QAbstractTableModel(parent)
-    , measurements(std::forward<QList<Measurements>>(data))
+    , dataset(std::move(data))
+    , measurements(dataset->getInstruction(instruction).measurements)
 {}
 
+void MeasurementModel::setInstruction(std::shared_ptr<Dataset> data, const uint32_t instruction) noexcept
+{
+    beginResetModel();
+    dataset = std::move(data);
+    measurements = dataset->getInstruction(instruction).measurements;
+    endResetModel();
+}
+
 int MeasurementModel::rowCount(const QModelIndex& /*parameter1*/) const noexcept
 {
-    return static_cast<int>(measurements.count());
+    return static_cast<int>(measurements.count);
 }
 
 int MeasurementModel::columnCount(const QModelIndex& /*parameter1*/) const noexcept
@@ -55,8 +64,8 @@ QVariant MeasurementModel::headerData(
                     break;
             }
         } else {
-            if (section < measurements.count()) {
-                return measurements.at(section).arch;
+            if (section >= 0 && static_cast<uint32_t>(section) < measurements.count) {
+                return dataset->getArchitecture(dataset->getMeasurement(measurements.offset + section).arch).toString();
             }
         }
     }
@@ -68,31 +77,31 @@ QVariant MeasurementModel::data(const QModelIndex& index, const int role) const
     if (!index.isValid()) {
         return "";
     }
-    if (role == Qt::DisplayRole && index.row() >= 0 && index.row() < measurements.count() && index.column() >= 0 &&
-        index.column() < 4) {
+    if (role == Qt::DisplayRole && index.row() >= 0 && static_cast<uint32_t>(index.row()) < measurements.count &&
+        index.column() >= 0 && index.column() < 4) {
+        const auto& item = dataset->getMeasurement(measurements.offset + static_cast<uint32_t>(index.row()));
         switch (index.column()) {
             case 0: {
-                if (const auto item = measurements.at(index.row());
-                    item.latency == item.latencyMem || item.latencyMem == UINT_MAX) {
+                if (item.latency == item.latencyMem || item.latencyMem == UINT_MAX) {
                     if (item.latency != UINT_MAX) {
-                        return QString::number(measurements.at(index.row()).latency);
+                        return QString::number(item.latency);
                     }
                     return QString();
                 } else {
                     QString ret('[');
-                    ret += QString::number(measurements.at(index.row()).latency);
+                    ret += QString::number(item.latency);
                     ret += ';';
-                    ret += QString::number(measurements.at(index.row()).latencyMem);
+                    ret += QString::number(item.latencyMem);
                     ret += ']';
                     return ret;
                 }
             }
             case 1:
-                return QString::number(measurements.at(index.row()).throughput);
+                return QString::number(item.throughput);
             case 2:
-                return QString::number(measurements.at(index.row()).uops);
+                return QString::number(item.uops);
             case 3:
-                return measurements.at(index.row()).ports;
+                return dataset->getPorts(item.ports).toString();
             default:
                 break;
         }
@@ -22,13 +22,76 @@ Row {
         Column {
             spacing: 0
             Label {
-                text: "<h3>Instruction Set</h3>"
+                text: "<h3>Performance</h3>"
                 verticalAlignment: Text.AlignVCenter
                 horizontalAlignment: Text.AlignLeft
                 textFormat: Text.StyledText
                 topPadding: 6
                 bottomPadding: 5
             }
+            GridLayout {
+                width: menuView.width - 22
+                columns: 2
+                columnSpacing: 10
+                Label {
+                    text: "Architecture"
+                    leftPadding: 6
+                    textFormat: Text.PlainText
+                }
+                ComboBox {
+                    Layout.fillWidth: true
+                    model: ["Any"].concat(intrinsicProxyModel.architectures)
+                    currentIndex: intrinsicProxyModel.architecture + 1
+                    onActivated: intrinsicProxyModel.setArchitecture(currentIndex - 1)
+                    ToolTip.visible: hovered
+                    ToolTip.text: "Only show intrinsics measured on the selected architecture"
+                }
+                Label {
+                    text: "Sort by"
+                    leftPadding: 6
+                    textFormat: Text.PlainText
+                }
+                ComboBox {
+                    Layout.fillWidth: true
+                    model: ["Name", "Latency", "Memory Latency", "Throughput", "Uops"]
+                    enabled: intrinsicProxyModel.architecture >= 0
+                    onActivated: intrinsicProxyModel.setSortMetric(currentIndex - 1)
+                }
+            }
+
+            Label {
+                text: "<h3>Instruction Set</h3>"
+                verticalAlignment: Text.AlignVCenter
+                horizontalAlignment: Text.AlignLeft
+                textFormat: Text.StyledText
+                topPadding: 10
+                bottomPadding: 5
+            }
+            Row {
+                leftPadding: 6
+                spacing: 2
+                ToolButton {
+                    text: "All"
+                    font.pointSize: 8
+                    onClicked: technologiesModel.setAllChecked(true)
+                    ToolTip.visible: hovered
+                    ToolTip.text: "Check all"
+                }
+                ToolButton {
+                    text: "None"
+                    font.pointSize: 8
+                    onClicked: technologiesModel.setAllChecked(false)
+                    ToolTip.visible: hovered
+                    ToolTip.text: "Uncheck all"
+                }
+                ToolButton {
+                    text: "Invert"
+                    font.pointSize: 8
+                    onClicked: technologiesModel.invertChecked()
+                    ToolTip.visible: hovered
+                    ToolTip.text: "Invert the checked items"
+                }
+            }
 
             Repeater {
                 model: technologiesModel
@@ -46,7 +109,11 @@ Row {
                             id: techCheck
                             checkable: true
                             checked: technologyChecked
-                            onToggled: technologiesModel.setData(technologiesModel.index(index, 0), checked, TechnologyModel.TechnologyRoleChecked)
+                            onToggled: {
+                                technologiesModel.setData(technologiesModel.index(index, 0), checked, TechnologyModel.TechnologyRoleChecked)
+                                // Toggling replaces the binding so it is restored to follow batch changes
+                                checked = Qt.binding(() => technologyChecked)
+                            }
                             scale: 0.7
                             topPadding: 0
                             bottomPadding: 0
@@ -66,6 +133,16 @@ Row {
                             Layout.fillWidth: true
                             verticalAlignment: Text.AlignVCenter
                             textFormat: Text.PlainText
+                            opacity: technologyCount > 0 || technologyChecked ? 1.0 : 0.5
+                        }
+                        Label {
+                            text: technologyCount
+                            rightPadding: 5
+                            topPadding: 0
+                            bottomPadding: 0
+                            verticalAlignment: Text.AlignVCenter
+                            textFormat: Text.PlainText
+                            opacity: 0.6
                         }
 
                     }
@@ -80,6 +157,31 @@ Row {
                 topPadding: 10
                 bottomPadding: 5
             }
+            Row {
+                leftPadding: 6
+                spacing: 2
+                ToolButton {
+                    text: "All"
+                    font.pointSize: 8
+                    onClicked: typesModel.setAllChecked(true)
+                    ToolTip.visible: hovered
+                    ToolTip.text: "Check all"
+                }
+                ToolButton {
+                    text: "None"
+                    font.pointSize: 8
+                    onClicked: typesModel.setAllChecked(false)
+                    ToolTip.visible: hovered
+                    ToolTip.text: "Uncheck all"
+                }
+                ToolButton {
+                    text: "Invert"
+                    font.pointSize: 8
+                    onClicked: typesModel.invertChecked()
+                    ToolTip.visible: hovered
+                    ToolTip.text: "Invert the checked items"
+                }
+            }
             Repeater {
                 model: typesModel
                 delegate: ItemDelegate {
@@ -96,7 +198,11 @@ Row {
                             id: typeCheck
                             checkable: true
                             checked: typeChecked
-                            onToggled: typesModel.setData(typesModel.index(index, 0), checked, TypeModel.TypeRoleChecked)
+                            onToggled: {
+                                typesModel.setData(typesModel.index(index, 0), checked, TypeModel.TypeRoleChecked)
+                                // Toggling replaces the binding so it is restored to follow batch changes
+                                checked = Qt.binding(() => typeChecked)
+                            }
                             scale: 0.7
                             topPadding: 0
                             bottomPadding: 0
@@ -109,6 +215,16 @@ Row {
                             Layout.fillWidth: true
                             verticalAlignment: Text.AlignVCenter
                             textFormat: Text.PlainText
+                            opacity: typeCount > 0 || typeChecked ? 1.0 : 0.5
+                        }
+                        Label {
+                            text: typeCount
+                            rightPadding: 5
+                            topPadding: 0
+                            bottomPadding: 0
+                            verticalAlignment: Text.AlignVCenter
+                            textFormat: Text.PlainText
+                            opacity: 0.6
                         }
 
                     }
@@ -123,6 +239,31 @@ Row {
                 topPadding: 10
                 bottomPadding: 5
             }
+            Row {
+                leftPadding: 6
+                spacing: 2
+                ToolButton {
+                    text: "All"
+                    font.pointSize: 8
+                    onClicked: categoriesModel.setAllChecked(true)
+                    ToolTip.visible: hovered
+                    ToolTip.text: "Check all"
+                }
+                ToolButton {
+                    text: "None"
+                    font.pointSize: 8
+                    onClicked: categoriesModel.setAllChecked(false)
+                    ToolTip.visible: hovered
+                    ToolTip.text: "Uncheck all"
+                }
+                ToolButton {
+                    text: "Invert"
+                    font.pointSize: 8
+                    onClicked: categoriesModel.invertChecked()
+                    ToolTip.visible: hovered
+                    ToolTip.text: "Invert the checked items"
+                }
+            }
             Repeater {
                 model: categoriesModel
                 delegate: ItemDelegate {
@@ -139,7 +280,11 @@ Row {
                             id: catCheck
                             checkable: true
                             checked: categoryChecked
-                            onToggled: categoriesModel.setData(categoriesModel.index(index, 0), checked, CategoryModel.CategoryRoleChecked)
+                            onToggled: {
+                                categoriesModel.setData(categoriesModel.index(index, 0), checked, CategoryModel.CategoryRoleChecked)
+                                // Toggling replaces the binding so it is restored to follow batch changes
+                                checked = Qt.binding(() => categoryChecked)
+                            }
                             scale: 0.7
                             topPadding: 0
                             bottomPadding: 0
@@ -152,6 +297,16 @@ Row {
                             Layout.fillWidth: true
                             verticalAlignment: Text.AlignVCenter
                             textFormat: Text.PlainText
+                            opacity: categoryCount > 0 || categoryChecked ? 1.0 : 0.5
+                        }
+                        Label {
+                            text: categoryCount
+                            rightPadding: 5
+                            topPadding: 0
+                            bottomPadding: 0
+                            verticalAlignment: Text.AlignVCenter
+                            textFormat: Text.PlainText
+                            opacity: 0.6
                         }
 
                     }
@@ -86,8 +86,8 @@ Item {
             anchors.rightMargin: 50
             anchors.leftMargin: 50
             selectByMouse: true
-            placeholderText: "Search"
-            onEditingFinished: intrinsicProxyModel.setFilterExpression(text)
+            placeholderText: "Search (e.g. tech:AVX2 mnemonic:vfmadd lat<=4@Zen4 !port:p5)"
+            onTextChanged: intrinsicProxyModel.setFilterExpression(text)
         }
         Pane {
             anchors.top: parent.top
@@ -158,9 +158,18 @@ Item {
             icon.source: "qrc:/refresh.png"
             icon.color: "transparent"
             flat: true
+            visible: !application.refreshing
             onDoubleClicked: application.resetData()
             ToolTip.visible: down
-            ToolTip.text: "Double click to force reloading data from the internet"
+            ToolTip.text: "Double click to check the internet for updated data"
+        }
+        BusyIndicator {
+            width: versionLabel.height
+            height: versionLabel.height
+            visible: application.refreshing
+            running: application.refreshing
+            ToolTip.visible: hovered
+            ToolTip.text: "Checking the internet for updated data"
         }
         Label {
             text: ")"
@@ -0,0 +1,64 @@
+/**
+ * Copyright Matthew Oliver
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PerformanceIndex.h"
+
+#include <climits>
+#include <limits>
+
+PerformanceIndex::PerformanceIndex(const Dataset& data) noexcept
+    : architectures(data.getArchitectures())
+    , count(data.getInstructionCount())
+{
+    // The stored architectures are already sorted so each measurement indexes its column directly
+    constexpr auto metrics = static_cast<qsizetype>(Metric::Count);
+    values.resize(architectures.size() * metrics * count, std::numeric_limits<float>::quiet_NaN());
+    for (uint32_t i = 0; i < data.getInstructionCount(); ++i) {
+        const auto& instruction = data.getInstruction(i);
+        for (uint32_t j = instruction.measurements.offset;
+             j < instruction.measurements.offset + instruction.measurements.count; ++j) {
+            const auto& measurement = data.getMeasurement(j);
+            float* column = &values[static_cast<qsizetype>(measurement.arch) * metrics * count];
+            // Unknown latencies are stored as the maximum value and unknown throughputs as 0
+            if (measurement.latency != UINT_MAX) {
+                column[static_cast<qsizetype>(Metric::Latency) * count + i] = static_cast<float>(measurement.latency);
+            }
+            if (measurement.latencyMem != UINT_MAX) {
+                column[static_cast<qsizetype>(Metric::LatencyMem) * count + i] =
+                    static_cast<float>(measurement.latencyMem);
+            }
+            if (measurement.throughput > 0.0F) {
+                column[static_cast<qsizetype>(Metric::Throughput) * count + i] = measurement.throughput;
+            }
+            column[static_cast<qsizetype>(Metric::Uops) * count + i] = static_cast<float>(measurement.uops);
+        }
+    }
+}
+
+const QList<QString>& PerformanceIndex::getArchitectures() const noexcept
+{
+    return architectures;
+}
+
+const float* PerformanceIndex::getColumn(const qsizetype arch, const Metric metric) const noexcept
+{
+    return &values[(arch * static_cast<qsizetype>(Metric::Count) + static_cast<qsizetype>(metric)) * count];
+}
+
+qsizetype PerformanceIndex::getCount() const noexcept
+{
+    return count;
+}
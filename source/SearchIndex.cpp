@@ -0,0 +1,175 @@
+/**
+ * Copyright Matthew Oliver
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "SearchIndex.h"
+
+#include "SearchQuery.h"
+
+#include <QElapsedTimer>
+
+#include <algorithm>
+#include <numeric>
+
+SearchIndex::SearchIndex(std::shared_ptr<Dataset> data) noexcept
+    : dataset(std::move(data))
+{
+    // Each field is indexed separately as a word can not be split across fields
+    const uint32_t count = dataset->getInstructionCount();
+    for (uint32_t i = 0; i < count; ++i) {
+        const auto& instruction = dataset->getInstruction(i);
+        addTrigrams(trigrams, dataset->getString(instruction.name), i);
+        addTrigrams(trigrams, dataset->getString(instruction.instruction), i);
+        addTrigrams(trigrams, dataset->getString(instruction.cpuidText), i);
+    }
+#ifdef _DEBUG
+    qDebug() << "Indexed" << trigrams.size() << "trigrams from" << count << "intrinsics";
+#endif
+}
+
+QList<uint32_t> SearchIndex::find(const QString& search, const std::atomic_bool* cancelled) const noexcept
+{
+    const auto isCancelled = [cancelled] { return cancelled != nullptr && cancelled->load(std::memory_order_relaxed); };
+    const SearchQuery query(search, *dataset);
+
+    // Only intrinsics containing every trigram of each word need to be checked. Words shorter than a trigram can not
+    // reduce the candidates so they are only checked against each candidate.
+    QList<uint32_t> candidates;
+    bool reduced = false;
+    for (const auto& word : query.getWords()) {
+        if (word.size() < 3) {
+            continue;
+        }
+        if (!reduced) {
+            if (!indexDescriptions(cancelled)) {
+                return {};
+            }
+            candidates = getRows(word.constData());
+            reduced = true;
+        }
+        filterCandidates(word, candidates);
+        if (candidates.isEmpty()) {
+            return {};
+        }
+    }
+    if (!reduced) {
+        candidates.resize(getCount());
+        std::iota(candidates.begin(), candidates.end(), 0U);
+    }
+
+    // Containing every trigram does not guarantee that they are in the correct order so each candidate is checked
+    QList<uint32_t> ret;
+    for (const auto i : candidates) {
+        if (isCancelled()) {
+            return {};
+        }
+        if (query.matches(*dataset, i)) {
+            ret.emplaceBack(i);
+        }
+    }
+    return ret;
+}
+
+uint32_t SearchIndex::getCount() const noexcept
+{
+    return dataset->getInstructionCount();
+}
+
+uint64_t SearchIndex::getTrigram(const QChar* chars) noexcept
+{
+    return (static_cast<uint64_t>(chars[0].unicode()) << 32) | (static_cast<uint64_t>(chars[1].unicode()) << 16) |
+        static_cast<uint64_t>(chars[2].unicode());
+}
+
+void SearchIndex::addTrigrams(TrigramMap& map, const QStringView text, const uint32_t row) noexcept
+{
+    // Rows are added in order so each list remains sorted and only needs checking for duplicates at its end
+    const QString lower = text.toString().toLower();
+    for (qsizetype i = 0; i + 3 <= lower.size(); ++i) {
+        auto& rows = map[getTrigram(lower.constData() + i)];
+        if (rows.isEmpty() || rows.last() != row) {
+            rows.emplaceBack(row);
+        }
+    }
+}
+
+bool SearchIndex::indexDescriptions(const std::atomic_bool* cancelled) const noexcept
+{
+    QMutexLocker lock(&descriptionMutex);
+    if (descriptionsIndexed) {
+        return true;
+    }
+#ifdef _DEBUG
+    QElapsedTimer indexTimer;
+    indexTimer.start();
+#endif
+    // The descriptions are read in order so that each compressed block only needs to be decompressed once. They are
+    // indexed separately so that a cancelled search never leaves a partial index behind.
+    TrigramMap map;
+    const uint32_t count = dataset->getInstructionCount();
+    for (uint32_t i = 0; i < count; ++i) {
+        if (cancelled != nullptr && cancelled->load(std::memory_order_relaxed)) {
+            return false;
+        }
+        addTrigrams(map, dataset->getDetail(dataset->getInstruction(i).description), i);
+    }
+    descriptionTrigrams = std::move(map);
+    descriptionsIndexed = true;
+#ifdef _DEBUG
+    qDebug() << "Indexed" << descriptionTrigrams.size() << "description trigrams in" << indexTimer.elapsed() << "ms";
+#endif
+    return true;
+}
+
+QList<uint32_t> SearchIndex::getRows(const QChar* chars) const noexcept
+{
+    const uint64_t trigram = getTrigram(chars);
+    const QList<uint32_t> rows = trigrams.value(trigram);
+    const QList<uint32_t> descriptionRows = descriptionTrigrams.value(trigram);
+    if (rows.isEmpty() || descriptionRows.isEmpty()) {
+        return rows.isEmpty() ? descriptionRows : rows;
+    }
+    QList<uint32_t> ret;
+    ret.reserve(rows.size() + descriptionRows.size());
+    std::set_union(
+        rows.cbegin(), rows.cend(), descriptionRows.cbegin(), descriptionRows.cend(), std::back_inserter(ret));
+    return ret;
+}
+
+void SearchIndex::filterCandidates(const QString& word, QList<uint32_t>& candidates) const noexcept
+{
+    // Intersect the smallest lists first so that the candidates shrink as quickly as possible
+    QList<QList<uint32_t>> lists;
+    for (qsizetype i = 0; i + 3 <= word.size(); ++i) {
+        QList<uint32_t> rows = getRows(word.constData() + i);
+        if (rows.isEmpty()) {
+            candidates.clear();
+            return;
+        }
+        lists.emplaceBack(std::move(rows));
+    }
+    std::sort(
+        lists.begin(), lists.end(), [](const auto& left, const auto& right) { return left.size() < right.size(); });
+    QList<uint32_t> intersection;
+    for (const auto& list : lists) {
+        if (candidates.isEmpty()) {
+            return;
+        }
+        intersection.clear();
+        std::set_intersection(candidates.cbegin(), candidates.cend(), list.cbegin(), list.cend(),
+            std::back_inserter(intersection));
+        candidates.swap(intersection);
+    }
+}
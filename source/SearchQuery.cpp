@@ -0,0 +1,288 @@
+/**
+ * Copyright Matthew Oliver
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "SearchQuery.h"
+
+#include <algorithm>
+#include <climits>
+#include <utility>
+
+SearchQuery::SearchQuery(const QString& search, const Dataset& data) noexcept
+{
+    // Split into terms on spaces that are not quoted
+    QString token;
+    bool quoted = false;
+    for (const QChar c : search) {
+        if (c == '"') {
+            quoted = !quoted;
+        } else if (c.isSpace() && !quoted) {
+            if (!token.isEmpty()) {
+                addTerm(std::move(token), data);
+                token = QString();
+            }
+        } else {
+            token += c;
+        }
+    }
+    if (!token.isEmpty()) {
+        addTerm(std::move(token), data);
+    }
+}
+
+const QList<QString>& SearchQuery::getWords() const noexcept
+{
+    return words;
+}
+
+bool SearchQuery::matches(const Dataset& data, const uint32_t index) const noexcept
+{
+    return std::all_of(terms.cbegin(), terms.cend(),
+        [&](const Term& term) { return matchesTerm(term, data, index) != term.negate; });
+}
+
+void SearchQuery::addTerm(QString token, const Dataset& data) noexcept
+{
+    Term term;
+    if (token.size() > 1 && token.front() == '!') {
+        term.negate = true;
+        token.remove(0, 1);
+    }
+
+    static const QList<std::pair<QString, Field>> fields = {
+        {    "tech", Field::Technology},
+        {    "type",       Field::Type},
+        {     "cat",   Field::Category},
+        {    "name",       Field::Name},
+        {"mnemonic", Field::Instruction},
+        {     "lat",    Field::Latency},
+        {  "latmem", Field::LatencyMem},
+        {      "tp", Field::Throughput},
+        {    "uops",       Field::Uops},
+        {    "port",       Field::Port}
+    };
+    qsizetype split = 0;
+    while (split < token.size() && !QStringView(u":<>=").contains(token[split])) {
+        ++split;
+    }
+    const QString key = token.left(split).toLower();
+    const auto found = std::find_if(
+        fields.cbegin(), fields.cend(), [&key](const std::pair<QString, Field>& field) { return field.first == key; });
+    if (split < token.size() && found != fields.cend()) {
+        term.field = found->second;
+    }
+
+    // Finds all names that match the value, preferring exact matches
+    const auto getMask = [](const QList<QString>& names, const QString& value) {
+        FilterMask mask;
+        for (qsizetype i = 0; i < std::min(names.size(), static_cast<qsizetype>(mask.size())); ++i) {
+            if (names[i].compare(value, Qt::CaseInsensitive) == 0) {
+                mask.set(static_cast<size_t>(i));
+            }
+        }
+        if (mask.none()) {
+            for (qsizetype i = 0; i < std::min(names.size(), static_cast<qsizetype>(mask.size())); ++i) {
+                if (names[i].contains(value, Qt::CaseInsensitive)) {
+                    mask.set(static_cast<size_t>(i));
+                }
+            }
+        }
+        return mask;
+    };
+
+    QString value = token.mid(split + 1);
+    switch (term.field) {
+        case Field::Technology:
+            term.mask = getMask(data.getTechnologies(), value);
+            break;
+        case Field::Type:
+            // Element types (e.g. FP32) are only stored by their display name
+            term.mask = getMask(data.getTypes(), InternalData::getTypeNames().value(value.toUpper(), value));
+            break;
+        case Field::Category:
+            term.mask = getMask(data.getCategories(), value);
+            break;
+        case Field::Name:
+        case Field::Instruction:
+            term.value = value.toLower();
+            break;
+        case Field::Latency:
+        case Field::LatencyMem:
+        case Field::Throughput:
+        case Field::Uops: {
+            // Get the comparison operator
+            const QStringView op = QStringView(token).mid(split);
+            if (op.startsWith(u"<=")) {
+                term.compare = Compare::LessEqual;
+            } else if (op.startsWith(u">=")) {
+                term.compare = Compare::GreaterEqual;
+            } else if (op.startsWith(u"<")) {
+                term.compare = Compare::Less;
+            } else if (op.startsWith(u">")) {
+                term.compare = Compare::Greater;
+            }
+            value = op.mid(op.size() > 1 && op[1] == '=' ? 2 : 1).toString();
+            if (const auto at = value.indexOf('@'); at >= 0) {
+                term.arch = value.mid(at + 1);
+                value.truncate(at);
+            }
+            bool valid = false;
+            term.number = value.toFloat(&valid);
+            if (!valid) {
+                // Not a valid comparison so search for it as text instead
+                term.field = Field::Text;
+            }
+            break;
+        }
+        case Field::Port: {
+            if (const auto at = value.indexOf('@'); at >= 0) {
+                term.arch = value.mid(at + 1);
+                value.truncate(at);
+            }
+            // Ports are named by a prefix followed by the port numbers (e.g. p015)
+            value = value.toLower();
+            qsizetype digits = 0;
+            while (digits < value.size() && !value[digits].isDigit()) {
+                ++digits;
+            }
+            term.value = digits > 0 ? value.left(digits) : QString("p");
+            term.digits = value.mid(digits);
+            break;
+        }
+        case Field::Text:
+            break;
+    }
+    if (term.field == Field::Text) {
+        term.value = token.toLower();
+        if (!term.negate) {
+            words.emplaceBack(term.value);
+        }
+    }
+    terms.emplaceBack(std::move(term));
+}
+
+bool SearchQuery::matchesTerm(const Term& term, const Dataset& data, const uint32_t index) noexcept
+{
+    const auto& instruction = data.getInstruction(index);
+    const auto inMask = [&data, &term](const Dataset::RangeRef& range) {
+        for (uint32_t i = range.offset; i < range.offset + range.count; ++i) {
+            if (const auto found = data.getIndex(i); found < term.mask.size() && term.mask.test(found)) {
+                return true;
+            }
+        }
+        return false;
+    };
+    const auto compare = [&term](const float value) {
+        switch (term.compare) {
+            case Compare::Less:
+                return value < term.number;
+            case Compare::LessEqual:
+                return value <= term.number;
+            case Compare::Equal:
+                return value == term.number;
+            case Compare::GreaterEqual:
+                return value >= term.number;
+            case Compare::Greater:
+                return value > term.number;
+        }
+        return false;
+    };
+    const auto usesPort = [&term](const QStringView ports) {
+        // Ports are listed as groups of uops and the ports they can use (e.g. 1*p015+1*p23)
+        for (const auto group : ports.split(u'+')) {
+            const QStringView name = group.mid(group.indexOf(u'*') + 1);
+            qsizetype digits = 0;
+            while (digits < name.size() && !name[digits].isDigit()) {
+                ++digits;
+            }
+            if (name.left(digits).compare(term.value, Qt::CaseInsensitive) != 0) {
+                continue;
+            }
+            const QStringView numbers = name.mid(digits);
+            if (std::all_of(term.digits.cbegin(), term.digits.cend(), [&numbers](const QChar c) {
+                    return numbers.contains(c);
+                })) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    switch (term.field) {
+        case Field::Text:
+            // The description has to be decompressed so it is only checked if no other field matches
+            return data.getString(instruction.name).contains(term.value, Qt::CaseInsensitive) ||
+                data.getString(instruction.instruction).contains(term.value, Qt::CaseInsensitive) ||
+                data.getString(instruction.cpuidText).contains(term.value, Qt::CaseInsensitive) ||
+                data.getDetail(instruction.description).contains(term.value, Qt::CaseInsensitive);
+        case Field::Technology:
+            return instruction.technology < term.mask.size() && term.mask.test(instruction.technology);
+        case Field::Type:
+            return inMask(instruction.types);
+        case Field::Category:
+            return inMask(instruction.categories);
+        case Field::Name:
+            return data.getString(instruction.name).contains(term.value, Qt::CaseInsensitive);
+        case Field::Instruction:
+            return data.getString(instruction.instruction).contains(term.value, Qt::CaseInsensitive);
+        case Field::Latency:
+        case Field::LatencyMem:
+        case Field::Throughput:
+        case Field::Uops:
+        case Field::Port:
+            break;
+    }
+
+    // Check if any measurement matches
+    for (uint32_t i = instruction.measurements.offset;
+         i < instruction.measurements.offset + instruction.measurements.count; ++i) {
+        const auto& measurement = data.getMeasurement(i);
+        if (!term.arch.isEmpty() &&
+            data.getArchitecture(measurement.arch).compare(term.arch, Qt::CaseInsensitive) != 0) {
+            continue;
+        }
+        switch (term.field) {
+            case Field::Latency:
+                // Unknown latencies are stored as the maximum value
+                if (measurement.latency != UINT_MAX && compare(static_cast<float>(measurement.latency))) {
+                    return true;
+                }
+                break;
+            case Field::LatencyMem:
+                if (measurement.latencyMem != UINT_MAX && compare(static_cast<float>(measurement.latencyMem))) {
+                    return true;
+                }
+                break;
+            case Field::Throughput:
+                if (measurement.throughput > 0.0F && compare(measurement.throughput)) {
+                    return true;
+                }
+                break;
+            case Field::Uops:
+                if (compare(static_cast<float>(measurement.uops))) {
+                    return true;
+                }
+                break;
+            case Field::Port:
+                if (usesPort(data.getPorts(measurement.ports))) {
+                    return true;
+                }
+                break;
+            default:
+                break;
+        }
+    }
+    return false;
+}
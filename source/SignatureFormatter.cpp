@@ -0,0 +1,145 @@
+/**
+ * Copyright Matthew Oliver
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "SignatureFormatter.h"
+
+constexpr qsizetype maxCached = 64;
+
+// Separates each part of a stored signature, this can never appear in a type or name
+constexpr char16_t separator = u'\x1F';
+
+QString SignatureFormatter::encode(
+    const QString& returnType, const QString& returnName, const QList<QPair<QString, QString>>& parameters) noexcept
+{
+    QString ret = returnType;
+    ret += separator;
+    ret += returnName;
+    for (const auto& [type, name] : parameters) {
+        ret += separator;
+        ret += type;
+        ret += separator;
+        ret += name;
+    }
+    return ret;
+}
+
+void SignatureFormatter::setColours(const QString& type, const QString& name) noexcept
+{
+    typeColour = type;
+    nameColour = name;
+    clear();
+}
+
+QString SignatureFormatter::formatSignature(
+    const uint32_t row, const QStringView name, const QString& signature) noexcept
+{
+    if (QString found = find(signatureCache, row); !found.isNull()) {
+        return found;
+    }
+    const auto style = [](QString& text, const QString& colour, const QStringView value) {
+        text += QLatin1StringView("<font color=\"");
+        text += colour;
+        text += QLatin1StringView("\">");
+        text += value;
+        text += QLatin1StringView("</font>");
+    };
+
+    // The return type and name are followed by the type and name of each parameter
+    const QList<QStringView> parts = QStringView(signature).split(separator);
+    QString ret;
+    style(ret, typeColour, parts.value(0));
+    ret += ' ';
+    ret += name;
+    ret += QLatin1StringView(" (");
+    for (qsizetype i = 2; i + 1 < parts.size(); i += 2) {
+        if (i > 2) {
+            ret += QLatin1StringView(", ");
+        }
+        style(ret, typeColour, parts[i]);
+        ret += ' ';
+        style(ret, nameColour, parts[i + 1]);
+    }
+    ret += ')';
+    insert(signatureCache, row, ret);
+    return ret;
+}
+
+QString SignatureFormatter::formatDescription(
+    const uint32_t row, const QString& signature, const QString& description) noexcept
+{
+    if (QString found = find(descriptionCache, row); !found.isNull()) {
+        return found;
+    }
+    // Every variable name in the signature may be referenced in quotes, the return type is not a variable name
+    QList<QStringView> names = QStringView(signature).split(separator);
+    for (qsizetype i = names.size() - 2; i >= 0; i -= 2) {
+        names.removeAt(i);
+    }
+
+    // Each quoted word is checked once instead of searching the whole description for each name
+    QString ret;
+    ret.reserve(description.size());
+    qsizetype position = 0;
+    for (qsizetype open = description.indexOf('"'); open >= 0; open = description.indexOf('"', position)) {
+        const qsizetype close = description.indexOf('"', open + 1);
+        if (close < 0) {
+            break;
+        }
+        const QStringView word = QStringView(description).sliced(open + 1, close - open - 1);
+        if (word.isEmpty() || !names.contains(word)) {
+            // The closing quote may instead start a quoted name
+            ret += QStringView(description).sliced(position, close - position);
+            position = close;
+            continue;
+        }
+        ret += QStringView(description).sliced(position, open - position);
+        ret += QLatin1StringView("<font color=\"");
+        ret += nameColour;
+        ret += QLatin1StringView("\">");
+        ret += word;
+        ret += QLatin1StringView("</font>");
+        position = close + 1;
+    }
+    ret += QStringView(description).sliced(position);
+    insert(descriptionCache, row, ret);
+    return ret;
+}
+
+void SignatureFormatter::clear() noexcept
+{
+    signatureCache.clear();
+    descriptionCache.clear();
+}
+
+QString SignatureFormatter::find(QList<QPair<uint32_t, QString>>& cache, const uint32_t row) noexcept
+{
+    for (qsizetype i = cache.size() - 1; i >= 0; --i) {
+        if (cache[i].first == row) {
+            cache.move(i, cache.size() - 1);
+            return cache.last().second;
+        }
+    }
+    return {};
+}
+
+void SignatureFormatter::insert(
+    QList<QPair<uint32_t, QString>>& cache, const uint32_t row, const QString& text) noexcept
+{
+    if (cache.size() >= maxCached) {
+        cache.removeFirst();
+    }
+    cache.emplaceBack(row, text);
+}
@@ -35,6 +35,8 @@ QVariant TechnologyModel::data(const QModelIndex& index, const int role) const n
                 return allTechnologies.at(index.row()).name;
             case TechnologyRoleChecked:
                 return allTechnologies.at(index.row()).checked;
+            case TechnologyRoleCount:
+                return allTechnologies.at(index.row()).count;
             default:
                 break;
         }
@@ -45,7 +47,10 @@ QVariant TechnologyModel::data(const QModelIndex& index, const int role) const n
 QHash<int, QByteArray> TechnologyModel::roleNames() const noexcept
 {
     static const QHash<int, QByteArray> roles{
-        {TechnologyRoleName, "technologyName"}, {TechnologyRoleChecked, "technologyChecked"}};
+        {TechnologyRoleName, "technologyName"},
+        {TechnologyRoleChecked, "technologyChecked"},
+        {TechnologyRoleCount, "technologyCount"},
+    };
     return roles;
 }
 
@@ -64,6 +69,9 @@ bool TechnologyModel::setData(const QModelIndex& index, const QVariant& value, c
         if (role == TechnologyRoleChecked) {
             // Update the value
             allTechnologies[index.row()].checked = value.toBool();
+            if (static_cast<size_t>(index.row()) < checkedMask.size()) {
+                checkedMask.set(static_cast<size_t>(index.row()), value.toBool());
+            }
             emit dataChanged(index, index, {role});
             emit technologyChanged();
             return true;
@@ -87,5 +95,125 @@ void TechnologyModel::load(QList<QString>& technologies) noexcept
     for (auto& i : technologies) {
         allTechnologies.emplaceBack(std::move(i));
     }
+    updateMask();
     emit endInsertRows();
 }
+
+void TechnologyModel::update(QList<QString>& technologies) noexcept
+{
+    // Remove any items that no longer exist
+    for (auto i = allTechnologies.count() - 1; i >= 0; --i) {
+        if (!technologies.contains(allTechnologies[i].name)) {
+            beginRemoveRows(QModelIndex(), static_cast<int>(i), static_cast<int>(i));
+            allTechnologies.removeAt(i);
+            endRemoveRows();
+        }
+    }
+    // Insert any new items in place
+    for (qsizetype i = 0; i < technologies.count(); ++i) {
+        if (i < allTechnologies.count() && allTechnologies[i].name == technologies[i]) {
+            continue;
+        }
+        if (allTechnologies.indexOf(technologies[i], i) != -1) {
+            // The existing items have been reordered so fall back to reloading while keeping the checked items
+            beginResetModel();
+            QList<StringChecked> old = std::move(allTechnologies);
+            for (auto& j : technologies) {
+                const auto found = std::find(old.cbegin(), old.cend(), j);
+                allTechnologies.emplaceBack(std::move(j)).checked = found != old.cend() && found->checked;
+            }
+            updateMask();
+            endResetModel();
+            return;
+        }
+        beginInsertRows(QModelIndex(), static_cast<int>(i), static_cast<int>(i));
+        allTechnologies.insert(i, StringChecked(QString(technologies[i])));
+        endInsertRows();
+    }
+    updateMask();
+}
+
+void TechnologyModel::setCounts(const QList<uint32_t>& counts) noexcept
+{
+    // Only the changed range is signalled so that unchanged delegates are not updated
+    qsizetype first = -1;
+    qsizetype last = -1;
+    for (qsizetype i = 0; i < std::min(allTechnologies.count(), counts.count()); ++i) {
+        if (allTechnologies[i].count != counts[i]) {
+            allTechnologies[i].count = counts[i];
+            first = first < 0 ? i : first;
+            last = i;
+        }
+    }
+    if (first >= 0) {
+        emit dataChanged(index(static_cast<int>(first)), index(static_cast<int>(last)), {TechnologyRoleCount});
+    }
+}
+
+void TechnologyModel::setAllChecked(const bool checked) noexcept
+{
+    FilterMask mask;
+    if (checked) {
+        for (qsizetype i = 0; i < std::min(allTechnologies.count(), static_cast<qsizetype>(mask.size())); ++i) {
+            mask.set(static_cast<size_t>(i));
+        }
+    }
+    setCheckedMask(mask);
+}
+
+void TechnologyModel::invertChecked() noexcept
+{
+    FilterMask mask = checkedMask;
+    for (qsizetype i = 0; i < std::min(allTechnologies.count(), static_cast<qsizetype>(mask.size())); ++i) {
+        mask.flip(static_cast<size_t>(i));
+    }
+    setCheckedMask(mask);
+}
+
+void TechnologyModel::setCheckedNames(const QList<QString>& names) noexcept
+{
+    FilterMask mask;
+    for (qsizetype i = 0; i < std::min(allTechnologies.count(), static_cast<qsizetype>(mask.size())); ++i) {
+        mask.set(static_cast<size_t>(i), names.contains(allTechnologies[i].name));
+    }
+    setCheckedMask(mask);
+}
+
+QList<QString> TechnologyModel::getCheckedNames() const noexcept
+{
+    QList<QString> ret;
+    for (const auto& i : allTechnologies) {
+        if (i.checked) {
+            ret.append(i.name);
+        }
+    }
+    return ret;
+}
+
+void TechnologyModel::setCheckedMask(const FilterMask& mask) noexcept
+{
+    // All items are updated before a single notification so that the filter is only updated once
+    qsizetype first = -1;
+    qsizetype last = -1;
+    for (qsizetype i = 0; i < std::min(allTechnologies.count(), static_cast<qsizetype>(mask.size())); ++i) {
+        if (const bool checked = mask.test(static_cast<size_t>(i)); allTechnologies[i].checked != checked) {
+            allTechnologies[i].checked = checked;
+            first = first < 0 ? i : first;
+            last = i;
+        }
+    }
+    if (first < 0) {
+        return;
+    }
+    updateMask();
+    emit dataChanged(index(static_cast<int>(first)), index(static_cast<int>(last)), {TechnologyRoleChecked});
+    emit technologyChanged();
+}
+
+void TechnologyModel::updateMask() noexcept
+{
+    checkedMask.reset();
+    for (qsizetype i = 0; i < std::min(allTechnologies.count(), static_cast<qsizetype>(checkedMask.size())); ++i) {
+        checkedMask.set(static_cast<size_t>(i), allTechnologies[i].checked);
+    }
+}
@@ -33,6 +33,8 @@ QVariant TypeModel::data(const QModelIndex& index, const int role) const noexcep
                 return allTypes.at(index.row()).name;
             case TypeRoleChecked:
                 return allTypes.at(index.row()).checked;
+            case TypeRoleCount:
+                return allTypes.at(index.row()).count;
             default:
                 break;
         }
@@ -42,7 +44,8 @@ QVariant TypeModel::data(const QModelIndex& index, const int role) const noexcep
 
 QHash<int, QByteArray> TypeModel::roleNames() const noexcept
 {
-    static const QHash<int, QByteArray> roles{{TypeRoleName, "typeName"}, {TypeRoleChecked, "typeChecked"}};
+    static const QHash<int, QByteArray> roles{
+        {TypeRoleName, "typeName"}, {TypeRoleChecked, "typeChecked"}, {TypeRoleCount, "typeCount"}};
     return roles;
 }
 
@@ -61,6 +64,9 @@ bool TypeModel::setData(const QModelIndex& index, const QVariant& value, const i
         if (role == TypeRoleChecked) {
             // Update the value
             allTypes[index.row()].checked = value.toBool();
+            if (static_cast<size_t>(index.row()) < checkedMask.size()) {
+                checkedMask.set(static_cast<size_t>(index.row()), value.toBool());
+            }
             emit dataChanged(index, index, {role});
             emit typesChanged();
             return true;
@@ -84,5 +90,125 @@ void TypeModel::load(QList<QString>& types) noexcept
     for (auto& i : types) {
         allTypes.emplaceBack(std::move(i));
     }
+    updateMask();
     emit endInsertRows();
 }
+
+void TypeModel::update(QList<QString>& types) noexcept
+{
+    // Remove any items that no longer exist
+    for (auto i = allTypes.count() - 1; i >= 0; --i) {
+        if (!types.contains(allTypes[i].name)) {
+            beginRemoveRows(QModelIndex(), static_cast<int>(i), static_cast<int>(i));
+            allTypes.removeAt(i);
+            endRemoveRows();
+        }
+    }
+    // Insert any new items in place
+    for (qsizetype i = 0; i < types.count(); ++i) {
+        if (i < allTypes.count() && allTypes[i].name == types[i]) {
+            continue;
+        }
+        if (allTypes.indexOf(types[i], i) != -1) {
+            // The existing items have been reordered so fall back to reloading while keeping the checked items
+            beginResetModel();
+            QList<StringChecked> old = std::move(allTypes);
+            for (auto& j : types) {
+                const auto found = std::find(old.cbegin(), old.cend(), j);
+                allTypes.emplaceBack(std::move(j)).checked = found != old.cend() && found->checked;
+            }
+            updateMask();
+            endResetModel();
+            return;
+        }
+        beginInsertRows(QModelIndex(), static_cast<int>(i), static_cast<int>(i));
+        allTypes.insert(i, StringChecked(QString(types[i])));
+        endInsertRows();
+    }
+    updateMask();
+}
+
+void TypeModel::setCounts(const QList<uint32_t>& counts) noexcept
+{
+    // Only the changed range is signalled so that unchanged delegates are not updated
+    qsizetype first = -1;
+    qsizetype last = -1;
+    for (qsizetype i = 0; i < std::min(allTypes.count(), counts.count()); ++i) {
+        if (allTypes[i].count != counts[i]) {
+            allTypes[i].count = counts[i];
+            first = first < 0 ? i : first;
+            last = i;
+        }
+    }
+    if (first >= 0) {
+        emit dataChanged(index(static_cast<int>(first)), index(static_cast<int>(last)), {TypeRoleCount});
+    }
+}
+
+void TypeModel::setAllChecked(const bool checked) noexcept
+{
+    FilterMask mask;
+    if (checked) {
+        for (qsizetype i = 0; i < std::min(allTypes.count(), static_cast<qsizetype>(mask.size())); ++i) {
+            mask.set(static_cast<size_t>(i));
+        }
+    }
+    setCheckedMask(mask);
+}
+
+void TypeModel::invertChecked() noexcept
+{
+    FilterMask mask = checkedMask;
+    for (qsizetype i = 0; i < std::min(allTypes.count(), static_cast<qsizetype>(mask.size())); ++i) {
+        mask.flip(static_cast<size_t>(i));
+    }
+    setCheckedMask(mask);
+}
+
+void TypeModel::setCheckedNames(const QList<QString>& names) noexcept
+{
+    FilterMask mask;
+    for (qsizetype i = 0; i < std::min(allTypes.count(), static_cast<qsizetype>(mask.size())); ++i) {
+        mask.set(static_cast<size_t>(i), names.contains(allTypes[i].name));
+    }
+    setCheckedMask(mask);
+}
+
+QList<QString> TypeModel::getCheckedNames() const noexcept
+{
+    QList<QString> ret;
+    for (const auto& i : allTypes) {
+        if (i.checked) {
+            ret.append(i.name);
+        }
+    }
+    return ret;
+}
+
+void TypeModel::setCheckedMask(const FilterMask& mask) noexcept
+{
+    // All items are updated before a single notification so that the filter is only updated once
+    qsizetype first = -1;
+    qsizetype last = -1;
+    for (qsizetype i = 0; i < std::min(allTypes.count(), static_cast<qsizetype>(mask.size())); ++i) {
+        if (const bool checked = mask.test(static_cast<size_t>(i)); allTypes[i].checked != checked) {
+            allTypes[i].checked = checked;
+            first = first < 0 ? i : first;
+            last = i;
+        }
+    }
+    if (first < 0) {
+        return;
+    }
+    updateMask();
+    emit dataChanged(index(static_cast<int>(first)), index(static_cast<int>(last)), {TypeRoleChecked});
+    emit typesChanged();
+}
+
+void TypeModel::updateMask() noexcept
+{
+    checkedMask.reset();
+    for (qsizetype i = 0; i < std::min(allTypes.count(), static_cast<qsizetype>(checkedMask.size())); ++i) {
+        checkedMask.set(static_cast<size_t>(i), allTypes[i].checked);
+    }
+}
@@ -24,6 +24,17 @@ ApplicationWindow {
     title: "Shift Intrinsic Guide"
     Universal.theme: Universal.Dark
 
+    // Signatures and descriptions are styled with colours that remain readable on the current theme
+    function updateSignatureColours() {
+        if (Universal.theme === Universal.Light) {
+            intrinsicsModel.setSignatureColours("rebeccapurple", "teal")
+        } else {
+            intrinsicsModel.setSignatureColours("mediumpurple", "lightseagreen")
+        }
+    }
+    Universal.onThemeChanged: updateSignatureColours()
+    Component.onCompleted: updateSignatureColours()
+
     Item {
         anchors.centerIn: parent
         width: infoDialog.width
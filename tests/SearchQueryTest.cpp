@@ -0,0 +1,103 @@
+/**
+ * Copyright Matthew Oliver
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Dataset.h"
+#include "SearchQuery.h"
+
+#include <QTest>
+
+#include <climits>
+
+class SearchQueryTest final : public QObject
+{
+    Q_OBJECT
+
+private:
+    /**
+     * Creates data containing a float32, an int16 and a float64 intrinsic, in that order. Only the float32 and int16
+     * intrinsics have a measurement, of which only the float32 one has a known memory latency.
+     * @returns The data.
+     */
+    [[nodiscard]] static std::shared_ptr<Dataset> createData() noexcept
+    {
+        // Types are stored by their display name in the same way as parsed upstream data
+        InternalData data;
+        data.allTechnologies = {"AVX"};
+        data.allTypes = {InternalData::getTypeNames()["FP32"], InternalData::getTypeNames()["FP64"],
+            InternalData::getTypeNames()["SI16"]};
+        data.allCategories = {"Arithmetic"};
+        const auto addInstruction = [&data](const QString& name, const uint32_t type, QList<Measurements> measured) {
+            data.instructions.emplaceBack(QString(), QString(name), QString(), QString(), QString(), QString(),
+                QString(data.allTypes[type]), QString("Arithmetic"), 0, QList<uint32_t>{type}, QList<uint32_t>{0},
+                QString(), std::move(measured));
+        };
+        addInstruction("_mm_add_ps", 0, {Measurements("Zen4", 3, 10, 0.5F, 1, "1*FP23")});
+        addInstruction("_mm_add_epi16", 2, {Measurements("Zen4", 1, UINT_MAX, 0.25F, 1, "1*FP0123")});
+        addInstruction("_mm_add_pd", 1, {});
+        return Dataset::open(Dataset::build(data));
+    }
+
+    /**
+     * Gets the intrinsics matching a search.
+     * @param data   The data to search.
+     * @param search The search string.
+     * @returns The indexes of each matching intrinsic.
+     */
+    [[nodiscard]] static QList<uint32_t> find(const Dataset& data, const QString& search) noexcept
+    {
+        const SearchQuery query(search, data);
+        QList<uint32_t> ret;
+        for (uint32_t i = 0; i < data.getInstructionCount(); ++i) {
+            if (query.matches(data, i)) {
+                ret.emplaceBack(i);
+            }
+        }
+        return ret;
+    }
+
+private slots:
+    void typeElementType()
+    {
+        const auto data = createData();
+        QVERIFY(data != nullptr);
+        QCOMPARE(find(*data, "type:FP32"), QList<uint32_t>{0});
+        QCOMPARE(find(*data, "type:fp32"), QList<uint32_t>{0});
+        QCOMPARE(find(*data, "type:SI16"), QList<uint32_t>{1});
+        QCOMPARE(find(*data, "!type:FP32"), (QList<uint32_t>{1, 2}));
+    }
+
+    void typeDisplayName()
+    {
+        const auto data = createData();
+        QVERIFY(data != nullptr);
+        QCOMPARE(find(*data, "type:\"Float32 (float)\""), QList<uint32_t>{0});
+        QCOMPARE(find(*data, "type:float"), (QList<uint32_t>{0, 2}));
+    }
+
+    void latencyMem()
+    {
+        const auto data = createData();
+        QVERIFY(data != nullptr);
+        QCOMPARE(find(*data, "latmem<=10"), QList<uint32_t>{0});
+        QCOMPARE(find(*data, "latmem>10"), QList<uint32_t>());
+        QCOMPARE(find(*data, "latmem=10@Zen4"), QList<uint32_t>{0});
+        QCOMPARE(find(*data, "lat<=3"), (QList<uint32_t>{0, 1}));
+    }
+};
+
+QTEST_APPLESS_MAIN(SearchQueryTest)
+
+#include "SearchQueryTest.moc"